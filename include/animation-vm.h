@@ -0,0 +1,57 @@
+#ifndef ANIMATION_VM_H
+#define ANIMATION_VM_H
+
+#include <Arduino.h>
+#include <FastLED.h>
+
+#define VM_REGISTER_COUNT 8
+#define VM_PROGRAM_SIZE 64         // Bytes for a program loaded over serial
+#define VM_MIN_WAVE_WIDTH 2        // Narrower waves have no falloff to draw
+#define VM_FRAME_INTERVAL 50       // Milliseconds between VM frames
+#define VM_BENCH_FRAMES 200        // Frames rendered per benchmark run
+#define VM_MIN_SPEED_PERCENT 80    // VM must reach this share of the hand-written speed
+
+// Animation bytecode. Each opcode is followed by its operand bytes; a frame
+// runs from the start of the program until END. Registers keep their value
+// between frames so programs can animate. Section masks use bit 0-3 for
+// sections 1-4. Drawing ops work on whole spans, not single pixels.
+enum VMOpcode : uint8_t {
+  VM_END,        // END                          - end of frame
+  VM_SET,        // SET reg lo hi                - reg = imm16
+  VM_ADD,        // ADD reg imm8                 - reg += signed imm8
+  VM_MOD,        // MOD reg lo hi                - reg %= imm16
+  VM_COLOR,      // COLOR r g b                  - set draw color
+  VM_HUE,        // HUE reg                      - set draw color to rainbow hue in reg
+  VM_CLEAR,      // CLEAR mask                   - clear sections
+  VM_FILL,       // FILL mask                    - fill sections with draw color
+  VM_WAVE,       // WAVE mask reg width stride   - wave at (reg + section * stride) in draw color
+  VM_BLEND,      // BLEND mask amount            - blend sections towards draw color
+  VM_FADE,       // FADE mask amount             - fade sections towards black
+  VM_SPARKLE,    // SPARKLE chance count         - white sparkles, chance in percent per sparkle
+  VM_HUESHIFT,   // HUESHIFT mask reg step       - rainbow from hue in reg, step per LED
+  VM_OPCODE_COUNT
+};
+
+struct VMState {
+  const uint8_t* program;          // Built-in program in flash, or loadedProgram
+  uint8_t length;
+  int16_t registers[VM_REGISTER_COUNT];
+  CRGB color;
+  uint8_t loadedProgram[VM_PROGRAM_SIZE];  // Validated copy of the upload, run by the VM
+  uint8_t uploadProgram[VM_PROGRAM_SIZE];  // Filled by 'vm add', never run directly
+  uint8_t uploadLength;
+};
+
+extern VMState vm;
+
+bool validateVMProgram(const uint8_t* program, int length);
+bool loadVMProgram(const uint8_t* program, int length);
+bool loadBuiltinVMProgram(int index);
+void clearLoadedVMProgram();
+bool appendVMProgram(const char* hex);
+bool runLoadedVMProgram();
+void resetVM();
+void runVMFrame();
+void benchmarkVM();
+
+#endif // ANIMATION_VM_H
@@ -0,0 +1,71 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <Arduino.h>
+
+#define LOOP_STATS_WINDOW 1000    // Loop iterations per averaging window
+#define EFFECT_BENCH_FRAMES 200   // Frames rendered per effect benchmark
+#define GOAL_LATENCY_BUDGET 200   // Default ms from beam clear to the first celebration frame on the strip:
+                                  // clear dwell + one sample + scoring and the first frame
+#define GOAL_LATENCY_BENCH_BLOCK 150  // ms the injected goal blocks the beam, a typical goal
+
+struct LoopStats {
+  unsigned long windowTotal;     // Sum of loop times in the current window (us)
+  unsigned long windowCount;     // Loops in the current window
+  unsigned long lastAverage;     // Average of the last complete window (us)
+  unsigned long maxTime;         // Longest loop since reset (us)
+  unsigned long consoleMaxTime;  // Longest serial console update since reset (us)
+};
+
+// Goal-to-light pipeline, in the order a goal passes through it
+enum LatencyStage : uint8_t {
+  LATENCY_VERDICT,               // Classifier accepted the goal
+  LATENCY_CELEBRATION,           // Celebration started
+  LATENCY_RENDERED,              // First celebration frame drawn, about to be sent
+  LATENCY_SHOWN,                 // First celebration frame sent to the strip
+  LATENCY_STAGES
+};
+
+struct GoalLatency {
+  uint32_t blocked;              // Beam break to beam clear (ms, sample clock)
+  uint32_t confirm;              // Beam clear to verdict (ms, sample clock)
+  uint32_t stageMicros[LATENCY_STAGES];
+  uint32_t controlled;           // Beam clear to frame shown (us), the part the firmware decides
+  uint32_t total;                // Beam break to frame shown (us)
+};
+
+struct LatencyStats {
+  GoalLatency current;           // Goal being measured
+  GoalLatency last;              // Last complete measurement
+  uint32_t worstControlled;      // us
+  uint16_t measured;
+  uint16_t overBudget;
+  uint8_t nextStage;             // LATENCY_STAGES while no goal is being measured
+};
+
+struct MemoryStats {
+  uint32_t minFreeHeap;          // Lowest free heap seen (bytes)
+  uint32_t minStackHeadroom;     // Lowest loop task stack high-water mark (bytes)
+};
+
+void recordLoopTime(unsigned long loopMicros);
+void recordConsoleTime(unsigned long consoleMicros);
+void resetLoopStats();
+void printLoopStats();
+
+// Render benchmarks
+unsigned long timeRender(void (*render)(), int frames);
+void benchmarkEffects();
+
+// Goal-to-light latency
+void beginGoalLatency(unsigned long breakTime, unsigned long clearTime, unsigned long verdictTime);
+void markGoalLatency(LatencyStage stage);
+void printGoalLatency(const GoalLatency &latency);
+void printLatencyStats();
+void benchmarkGoalLatency();
+
+// Memory budget
+void updateMemoryStats();
+void printMemoryReport();
+
+#endif // DIAGNOSTICS_H
@@ -0,0 +1,62 @@
+#ifndef GOAL_CLASSIFIER_H
+#define GOAL_CLASSIFIER_H
+
+#include <Arduino.h>
+
+#define BEAM_HISTORY_SIZE 8          // Beam-block intervals remembered per goal
+
+// Default signature rules (runtime values live in settings)
+#define GOAL_MAX_BLOCK_TIME 800      // ms - longer is a hand or a lodged ball
+#define GOAL_REBREAK_WINDOW 1000     // ms looked back at the verdict when counting breaks
+#define GOAL_MAX_REBREAKS 2          // more breaks in the window is the ball rattling at the mouth
+
+// Breaks only join one event when the beam clears for less than the clear
+// dwell in between. The re-break count also includes earlier events inside the
+// window, but a verdict never waits for later breaks. So the first break of
+// a rattle whose gaps are longer than the dwell is judged alone and can score.
+// Only the breaks after it are rejected.
+#define GOAL_CLEAR_DWELL 150         // ms the beam must stay clear before an event is classified;
+                                     // shorter lets a rattle's breaks score one by one
+
+enum BeamVerdict : uint8_t {
+  BEAM_NONE,                 // Nothing to report this sample
+  BEAM_GOAL,                 // Event matches a goal
+  BEAM_NOISE,                // Single-sample glitch, ignored silently
+  BEAM_REJECT_SHORT,         // Blocked for less than the minimum time
+  BEAM_REJECT_LONG,          // Blocked for longer than the maximum time
+  BEAM_REJECT_REBREAK        // Too many breaks in the re-break window
+};
+
+struct BeamInterval {
+  uint32_t start;
+  uint16_t duration;         // ms
+};
+
+// Features of the event being classified (or the last one)
+struct BeamFeatures {
+  uint16_t longestBlock;     // Longest single block (ms)
+  uint16_t totalBlocked;     // Sum of block times in the event (ms)
+  uint8_t breaks;            // Breaks in this event
+  uint8_t rebreaks;          // Breaks in the re-break window, including this event
+};
+
+struct BeamClassifier {
+  BeamInterval history[BEAM_HISTORY_SIZE];
+  uint8_t historyHead;       // Next slot to write
+  uint8_t historyCount;
+  bool blocked;
+  bool pending;              // Event in progress, waiting for the beam to stay clear
+  bool reported;             // Event already rejected while still blocked
+  uint32_t eventStart;       // First break of the current event
+  uint32_t blockStart;
+  uint32_t lastClear;
+  BeamFeatures features;
+};
+
+void resetBeamClassifier(BeamClassifier &classifier);
+BeamVerdict classifyBeamSample(BeamClassifier &classifier, bool blocked, unsigned long now);
+uint8_t countRecentBreaks(const BeamClassifier &classifier, unsigned long now, unsigned long window);
+const char* getBeamVerdictName(BeamVerdict verdict);
+void printBeamEvent(const char* goalName, BeamVerdict verdict, const BeamFeatures &features);
+
+#endif // GOAL_CLASSIFIER_H
@@ -0,0 +1,23 @@
+#ifndef GOLDEN_FRAMES_H
+#define GOLDEN_FRAMES_H
+
+#include <Arduino.h>
+#include "led-controller.h"
+
+#define GOLDEN_EFFECT_COUNT 10     // Every LEDEffect, LED_OFF to LED_GAME_WIN_CELEBRATION_B
+#define GOLDEN_FRAMES 32           // Frames rendered and checked per effect
+#define GOLDEN_FRAME_INTERVAL 20   // ms per frame on the virtual clock
+#define GOLDEN_SEED 0x5EED1234     // Sparkle seed for every effect run
+#define GOLDEN_BRIGHTNESS 255      // Brightness requested before each effect run
+
+// Per-frame CRC-32 (see getFrameChecksum) of every effect rendered from a
+// cleared strip with the fixed seed and virtual clock above
+extern const uint32_t goldenFrameCRCs[GOLDEN_EFFECT_COUNT][GOLDEN_FRAMES];
+
+const char* getGoldenEffectName(int effect);
+void beginGoldenEffect(LEDEffect effect);
+uint32_t renderGoldenFrame(LEDEffect effect, int frameIndex);
+bool checkGoldenEffect(LEDEffect effect, bool printTable, bool dumpMismatch);
+bool runGoldenFrames(bool printTable);
+
+#endif // GOLDEN_FRAMES_H
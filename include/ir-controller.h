@@ -2,25 +2,28 @@
 #define IR_CONTROLLER_H
 
 #include <Arduino.h>
+#include "goal-classifier.h"
+#include "sensor-health.h"
 
 #define IR_SENSOR_GOAL_1_PIN 18    // IR sensor for goal 1 (Team A)
 #define IR_SENSOR_GOAL_2_PIN 19    // IR sensor for goal 2 (Team B)
 
+#define IR_SAMPLE_INTERVAL 10      // Milliseconds between sensor samples
 #define IR_DEBOUNCE_TIME 500       // Debounce time in milliseconds
-#define IR_BLOCKED_THRESHOLD 10    // Number of consecutive readings to confirm goal
+#define IR_BLOCKED_THRESHOLD 10    // Minimum blocked samples for a goal (x IR_SAMPLE_INTERVAL ms)
 
 // Game configuration
 #define POINTS_TO_WIN 10           // Points needed to win a game
 
 // Game states
-enum GameState {
+enum GameState : uint8_t {
   GAME_ACTIVE,
   GAME_WON_TEAM_A,
   GAME_WON_TEAM_B,
   GAME_CELEBRATION
 };
 
-enum Team {
+enum Team : uint8_t {
   TEAM_A = 1,
   TEAM_B = 2
 };
@@ -31,8 +34,25 @@ struct GoalEvent {
   bool isValid;
 };
 
+// Per-goal beam detection state
+struct GoalSensor {
+  uint32_t lastTriggerTime;
+  BeamClassifier classifier;
+  SensorHealthState health;
+};
+
+struct DetectionState {
+  uint32_t lastGoalTime;
+  uint32_t lastSensorCheck;
+  GoalSensor sensors[2];     // 0 = Goal 1 (Team A), 1 = Goal 2 (Team B)
+};
+
 void initIRSensors();
 void updateIRSensors();
+void updateGoalSensor(int index, bool triggered, unsigned long currentTime);
+const char* getGoalName(Team team);
+void onSensorHealthChanged(Team team, SensorHealth health);
+void printSensorStatus();
 GoalEvent checkForGoal();
 bool isGoalDetected(int sensorPin);
 void resetGoalDetection();
@@ -53,9 +73,10 @@ bool readIRSensor(int pin);
 void printGoalEvent(GoalEvent event);
 
 // Score and game state variables
-extern int scoreTeamA;
-extern int scoreTeamB;
+extern uint8_t scoreTeamA;
+extern uint8_t scoreTeamB;
 extern GameState currentGameState;
+extern DetectionState detection;
 
 void incrementScore(Team team);
 void resetScore();
@@ -9,6 +9,7 @@
 #define LED_TYPE WS2812B
 #define COLOR_ORDER GRB
 #define BRIGHTNESS 150  
+#define WAVE_WIDTH 20        // LEDs under a color or rainbow wave
 
 #define SECTION_1_START 0    // 120cm = 72 LEDs (0-71)
 #define SECTION_1_END 71
@@ -21,28 +22,129 @@
 #define UNUSED_START 228     // Remaining LEDs (228-299)
 #define UNUSED_END 299
 
+// Sections running along each goal, used for sensor diagnostics (0-based)
+#define GOAL_1_SECTION 1             // Section 2 (Team A goal)
+#define GOAL_2_SECTION 3             // Section 4 (Team B goal)
+#define FAULT_BLINK_INTERVAL 500     // ms per on/off phase of the fault pattern
+
 // Celebration settings
 #define GOAL_CELEBRATION_DURATION 3000    // 3 seconds for goal celebration
 #define GAME_WIN_CELEBRATION_DURATION 10000  // 10 seconds for game win celebration
 #define CELEBRATION_WAVE_SPEED 30          // Faster wave for celebration
 #define GAME_WIN_WAVE_SPEED 20             // Even faster for game win
+#define GOAL_SPARKLES 1                    // Sparkle attempts per goal celebration frame
+#define GOAL_SPARKLE_CHANCE 30             // Percent chance per attempt
+#define GAME_WIN_SPARKLES 5                // Sparkle attempts per game win frame
+#define GAME_WIN_SPARKLE_CHANCE 60         // Percent chance per attempt
+
+// Uncomment (or pass -DLED_FRAME_TRACE) to print a checksum for every frame sent,
+// so effect output can be captured and compared between firmware versions
+// #define LED_FRAME_TRACE
+
+// Power model (per LED at full brightness, 5V WS2812B) and governor
+#define POWER_MA_RED 16                    // mA for a fully lit red channel
+#define POWER_MA_GREEN 11                  // mA for a fully lit green channel
+#define POWER_MA_BLUE 15                   // mA for a fully lit blue channel
+#define POWER_MA_IDLE 1                    // mA drawn by a dark LED
+#define POWER_BUDGET_MA 8000               // Default strip budget, 0 disables the governor
+#define POWER_RAMP_STEP 8                  // Brightness regained per ramp step after limiting
+#define POWER_RAMP_INTERVAL 20             // ms between ramp steps
+
+// Celebration queue settings
+#define CELEBRATION_QUEUE_SIZE 4           // Max pending celebrations
+#define GOAL_CELEBRATION_MIN_DURATION 1000 // Goal celebration is cut to this when more are waiting
+
+// Celebration priorities (higher preempts lower)
+#define CELEBRATION_PRIORITY_GOAL 1
+#define CELEBRATION_PRIORITY_GAME_WIN 2
 
 // Team colors
 #define TEAM_A_COLOR CRGB::Yellow       // Team A = Yellow
 #define TEAM_B_COLOR CRGB::Orange       // Team B = Orange
 
-enum LEDEffect {
+enum LEDEffect : uint8_t {
   LED_OFF,
   LED_FULL_WHITE,
   LED_COLOR_WAVE,
   LED_RAINBOW_WAVE,
   LED_BREATHING,
+  LED_VM_PROGRAM,                    // Bytecode animation, see animation-vm.h
   LED_GOAL_CELEBRATION_A,            // Goal celebration for Team A
   LED_GOAL_CELEBRATION_B,            // Goal celebration for Team B
   LED_GAME_WIN_CELEBRATION_A,        // Game win celebration for Team A
   LED_GAME_WIN_CELEBRATION_B         // Game win celebration for Team B
 };
 
+// Inclusive LED index range, empty when end < start
+struct DirtyRange {
+  int16_t start;
+  int16_t end;
+};
+
+struct CelebrationRequest {
+  LEDEffect effect;
+  CRGB color;
+  uint8_t priority;
+};
+
+// Effect animation state
+struct LEDState {
+  uint32_t lastUpdate;
+  uint32_t frameTime;                // Time the current frame is rendered for
+  uint32_t randomState;              // Sparkle PRNG state, see setEffectRandomSeed
+  uint16_t wavePosition;
+  CRGB waveColor;
+  LEDEffect currentEffect;
+  LEDEffect previousEffect;          // Effect to return to after a celebration
+  uint8_t breathingPhase;            // Index into the breathing curve
+};
+
+// Running celebration and the pending ones, highest priority first (FIFO within a priority)
+struct CelebrationState {
+  uint32_t startTime;
+  CRGB color;
+  LEDEffect effect;
+  bool active;
+  uint8_t queueCount;
+  CelebrationRequest queue[CELEBRATION_QUEUE_SIZE];
+};
+
+// Dirty tracking: pixels changed since the last show, and pixels currently lit
+struct FrameState {
+  DirtyRange dirty[4];
+  DirtyRange lit[4];
+  uint32_t framesShown;
+  uint32_t framesSkipped;
+  bool unsectionedDirty;
+  bool brightnessChanged;
+};
+
+// Power governor: channel sums are kept up to date by setPixel, so the
+// estimate never needs a separate pass over the LED buffer
+struct PowerState {
+  uint32_t channelSums[3];           // Sum of r, g and b over all LEDs
+  uint32_t lastRampTime;
+  uint32_t limitedFrames;            // Frames sent with brightness reduced by the governor
+  uint16_t estimatedMilliamps;       // Estimate for the last frame sent
+  uint16_t peakMilliamps;
+  uint8_t requestedBrightness;       // Brightness asked for by effects and settings
+  uint8_t governedBrightness;        // Brightness actually sent
+  bool limiting;
+};
+
+// Sensor fault pattern drawn over the running effect
+struct FaultOverlay {
+  CRGB colors[4];
+  uint8_t sections;                  // Bit per section with a fault
+};
+
+extern CRGB leds[NUM_LEDS];
+extern LEDState ledState;
+extern CelebrationState celebration;
+extern FrameState frame;
+extern FaultOverlay faultOverlay;
+extern PowerState power;
+
 void initLEDs();
 void updateLEDs();
 void setLEDEffect(LEDEffect effect);
@@ -51,22 +153,68 @@ void setBrightness(uint8_t brightness);
 
 void triggerGoalCelebration(int team); // team: 1 = Team A, 2 = Team B
 void triggerGameWinCelebration(int team); // team: 1 = Team A, 2 = Team B
+void renderCelebrationFrame();
 void showGoalCelebration();
+void renderGoalCelebration();
 void showGameWinCelebration();
+void renderGameWinCelebration();
 bool isCelebrationActive();
 void endCelebration();
 
+// Celebration queue
+bool queueCelebration(LEDEffect effect, CRGB color, uint8_t priority);
+void startCelebration(CelebrationRequest request);
+bool startNextCelebration();
+int getQueuedCelebrationCount();
+void clearCelebrationQueue();
+
 void showFullWhite();
+void renderFullWhite();
 void showColorWave();
+void renderColorWave();
+void renderWaveSection(int section, int waveCenter, int waveWidth, CRGB color);
 void showRainbowWave();
+void renderRainbowWave();
 void showBreathing();
+void renderBreathing();
 void turnOffLEDs();
+void redrawCurrentEffect();
 
 void fillSection(int startLED, int endLED, CRGB color);
 void fadeSection(int startLED, int endLED, uint8_t fadeAmount);
 int getSectionStart(int section);
 int getSectionEnd(int section);
 int getSectionLength(int section);
+int getSectionIndex(int index);
+bool getWaveWindow(int section, int waveCenter, int waveWidth, int &windowStart, int &windowEnd);
+
+// Dirty tracking - all pixel writes go through these so unchanged frames are never sent
+void setPixel(int index, CRGB color);
+void setSectionPixel(int section, int index, CRGB color);
+void clearSection(int section);
+void clearSectionOutside(int section, int keepStart, int keepEnd);
+void clearAllSections();
+void applyBrightness(uint8_t brightness);
+uint32_t getFullScaleMilliamps();
+void governBrightness();
+bool isFrameDirty();
+void showLEDs();
+
+// Sensor fault diagnostics
+void setSectionFault(int section, bool fault, CRGB color);
+void drawFaultOverlay();
+DirtyRange getSectionDirtyRange(int section);
+unsigned long getFramesShown();
+unsigned long getFramesSkipped();
+void printFrameStats();
+
+// Frame verification - checksums and dumps of the visible sections
+uint32_t getFrameChecksum();
+void printFrameChecksum();
+void dumpFrame();
+void setEffectRandomSeed(uint32_t seed);
+uint32_t effectRandom();
+uint16_t effectRandomRange(uint16_t range);
 
 uint8_t getWaveIntensity(int position, int waveCenter, int waveWidth);
 CRGB blendColors(CRGB color1, CRGB color2, uint8_t blend);
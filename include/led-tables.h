@@ -0,0 +1,94 @@
+#ifndef LED_TABLES_H
+#define LED_TABLES_H
+
+#include <Arduino.h>
+#include "led-controller.h"
+
+#define BREATHING_MIN_BRIGHTNESS 20    // Lowest point of the breathing curve
+
+// Lookup tables generated at compile time so the render path only indexes
+// arrays. Requires C++17 (see build_flags in platformio.ini).
+
+struct RGBEntry {
+  uint8_t r;
+  uint8_t g;
+  uint8_t b;
+};
+
+struct HueOffsetTable {
+  uint8_t values[NUM_LEDS];      // Rainbow hue offset of each LED along the strip
+};
+
+struct RainbowTable {
+  RGBEntry values[256];          // Fully saturated rainbow color for each hue
+};
+
+struct CurveTable {
+  uint8_t values[256];
+};
+
+constexpr uint8_t tableScale8(uint8_t value, uint8_t scale) {
+  return ((uint16_t)value * (1 + scale)) >> 8;
+}
+
+constexpr HueOffsetTable makeHueOffsetTable() {
+  HueOffsetTable table = {};
+  for (int i = 0; i < NUM_LEDS; i++) {
+    table.values[i] = i * 255 / NUM_LEDS;
+  }
+  return table;
+}
+
+// FastLED's "rainbow" hue mapping at full saturation and value, which gives
+// yellow and orange more room than a plain spectrum
+constexpr RainbowTable makeRainbowTable() {
+  RainbowTable table = {};
+  for (int hue = 0; hue < 256; hue++) {
+    uint8_t offset8 = (hue & 0x1F) << 3;
+    uint8_t third = tableScale8(offset8, 85);
+    uint8_t twoThirds = tableScale8(offset8, 170);
+    RGBEntry rgb = {0, 0, 0};
+    
+    switch (hue >> 5) {
+      case 0: rgb = {(uint8_t)(255 - third), third, 0}; break;
+      case 1: rgb = {171, (uint8_t)(85 + third), 0}; break;
+      case 2: rgb = {(uint8_t)(171 - twoThirds), (uint8_t)(170 + third), 0}; break;
+      case 3: rgb = {0, (uint8_t)(255 - third), third}; break;
+      case 4: rgb = {0, (uint8_t)(171 - twoThirds), (uint8_t)(85 + twoThirds)}; break;
+      case 5: rgb = {third, 0, (uint8_t)(255 - third)}; break;
+      case 6: rgb = {(uint8_t)(85 + third), 0, (uint8_t)(171 - third)}; break;
+      case 7: rgb = {(uint8_t)(170 + third), 0, (uint8_t)(85 - third)}; break;
+    }
+    table.values[hue] = rgb;
+  }
+  return table;
+}
+
+// Perceptual brightness, gamma ~2.2 approximated as 0.8 * x^2 + 0.2 * x^3
+constexpr CurveTable makeGammaTable() {
+  CurveTable table = {};
+  for (uint32_t x = 0; x < 256; x++) {
+    table.values[x] = (4 * x * x * 255 + x * x * x + 325125 / 2) / 325125;
+  }
+  return table;
+}
+
+// One breathing cycle: a triangle ramp through the gamma curve, scaled
+// between BREATHING_MIN_BRIGHTNESS and full brightness
+constexpr CurveTable makeBreathingTable() {
+  CurveTable gamma = makeGammaTable();
+  CurveTable table = {};
+  for (int phase = 0; phase < 256; phase++) {
+    uint8_t ramp = (phase < 128) ? phase * 2 : (255 - phase) * 2;
+    table.values[phase] = BREATHING_MIN_BRIGHTNESS +
+                          gamma.values[ramp] * (255 - BREATHING_MIN_BRIGHTNESS) / 255;
+  }
+  return table;
+}
+
+extern const HueOffsetTable hueOffsetTable;
+extern const RainbowTable rainbowTable;
+extern const CurveTable gammaTable;
+extern const CurveTable breathingTable;
+
+#endif // LED_TABLES_H
@@ -0,0 +1,44 @@
+#ifndef MATCH_STATS_H
+#define MATCH_STATS_H
+
+#include <Arduino.h>
+#include "ir-controller.h"
+
+#define GOAL_INTERVAL_BUCKETS 8    // Histogram buckets for time between goals
+
+// Live statistics for the current match. Fixed size, no heap, and every
+// field is updated in constant time per goal.
+struct MatchStats {
+  unsigned long startTime;
+  unsigned long endTime;           // 0 while the match is running
+  unsigned long lastGoalTime;      // 0 before the first goal
+  unsigned long totalInterval;     // Sum of times between goals (ms)
+  unsigned long shortestInterval;
+  unsigned long longestInterval;
+  uint16_t intervalCount;
+  uint8_t goalsTeamA;
+  uint8_t goalsTeamB;
+  Team streakTeam;                 // Team that scored the current streak
+  uint8_t streakLength;
+  uint8_t longestStreakTeamA;
+  uint8_t longestStreakTeamB;
+  uint8_t maxDeficitTeamA;         // Largest deficit Team A has faced
+  uint8_t maxDeficitTeamB;         // Largest deficit Team B has faced
+  uint16_t intervalHistogram[GOAL_INTERVAL_BUCKETS];
+};
+
+extern MatchStats matchStats;
+
+void resetMatchStats(unsigned long startTime);
+void recordGoalEvent(GoalEvent event);
+void endMatchStats(unsigned long endTime);
+const MatchStats& getMatchStats();
+
+unsigned long getMatchDuration(unsigned long now);
+float getGoalsPerMinute(unsigned long now);
+unsigned long getAverageGoalInterval();
+uint8_t getComebackMargin();
+int getIntervalBucket(unsigned long interval);
+void printMatchStats();
+
+#endif // MATCH_STATS_H
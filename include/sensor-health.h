@@ -0,0 +1,34 @@
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+
+#include <Arduino.h>
+
+#define SENSOR_STUCK_BLOCKED_TIME 5000      // ms blocked before the beam counts as stuck (lodged ball, dead emitter)
+#define SENSOR_STUCK_CLEAR_TIME 900000UL    // ms without a break while the other goal sees breaks
+#define SENSOR_FLICKER_WINDOW 1000          // ms per flicker rate measurement
+#define SENSOR_FLICKER_LIMIT 20             // Transitions per window above which the sensor is flickering
+
+enum SensorHealth : uint8_t {
+  SENSOR_OK,
+  SENSOR_STUCK_BLOCKED,      // Beam blocked for too long - goal can't score
+  SENSOR_STUCK_CLEAR,        // Beam never breaks - emitter/receiver misaligned?
+  SENSOR_FLICKERING          // Reading toggles too often to trust
+};
+
+struct SensorHealthState {
+  uint32_t blockedSince;     // Start of the current blocked stretch
+  uint32_t lastBreak;        // Last clear -> blocked transition
+  uint32_t lastGood;         // Last sample taken while healthy
+  uint32_t flickerWindowStart;
+  uint16_t flickerCount;     // Transitions in the current window
+  uint16_t flickerRate;      // Transitions in the last complete window
+  bool lastReading;
+  SensorHealth health;
+};
+
+void resetSensorHealth(SensorHealthState &state, unsigned long now);
+bool updateSensorHealth(SensorHealthState &state, bool blocked, unsigned long otherLastBreak, unsigned long now);
+bool canSensorScore(const SensorHealthState &state);
+const char* getSensorHealthName(SensorHealth health);
+
+#endif // SENSOR_HEALTH_H
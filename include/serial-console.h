@@ -0,0 +1,28 @@
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <Arduino.h>
+
+#define CONSOLE_BUFFER_SIZE 48        // Longest accepted command line
+#define CONSOLE_BYTES_PER_UPDATE 8    // Bytes consumed per loop so parsing never stalls rendering
+#define CONSOLE_MAX_TOKENS 4          // Command plus arguments
+#define CONSOLE_BAUD_RATE 115200      // Serial monitor speed
+#define CONSOLE_TX_BUFFER_SIZE 8192   // Replies are queued here and sent by the UART driver so they
+                                      // don't stall the loop. Sized for the longest: 'golden table'
+                                      // ~4.4 KB, 'dump' ~2.8 KB, a failing 'golden' ~3.2 KB
+
+struct ConsoleState {
+  char buffer[CONSOLE_BUFFER_SIZE];
+  uint8_t length;
+  bool overflow;             // Line too long, discard until newline
+};
+
+extern ConsoleState console;
+
+void initConsole();
+void updateConsole();
+void handleCommand(char* line);
+bool handleVMCommand(const char* action, const char* arg);
+void printConsoleHelp();
+
+#endif // SERIAL_CONSOLE_H
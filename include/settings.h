@@ -0,0 +1,32 @@
+#ifndef SETTINGS_H
+#define SETTINGS_H
+
+#include <Arduino.h>
+
+#define SETTINGS_NAMESPACE "soccer"    // NVS namespace for persisted settings
+
+// Runtime-tunable parameters. Defaults come from the compile-time #defines
+// in the other headers; values can be changed over serial and saved to NVS.
+struct Settings {
+  uint8_t pointsToWin;
+  uint8_t irBlockedThreshold;
+  uint16_t irDebounceTime;
+  uint8_t brightness;
+  uint16_t goalCelebrationDuration;
+  uint16_t gameWinCelebrationDuration;
+  uint16_t powerBudget;              // Strip current budget in mA, 0 = unlimited
+  uint16_t latencyBudget;            // Beam clear to first celebration frame, ms
+  uint16_t goalMaxBlockTime;         // Beam signature rules, see goal-classifier.h
+  uint16_t goalRebreakWindow;
+  uint8_t goalMaxRebreaks;
+  uint8_t goalClearDwell;
+};
+
+extern Settings settings;
+
+void resetSettings();
+void loadSettings();
+void saveSettings();
+void printSettings();
+
+#endif // SETTINGS_H
@@ -0,0 +1,284 @@
+#include "animation-vm.h"
+#include "led-controller.h"
+#include "led-tables.h"
+
+// Operand bytes following each opcode
+const uint8_t vmOperandCount[VM_OPCODE_COUNT] = {
+  0, // END
+  3, // SET
+  2, // ADD
+  3, // MOD
+  3, // COLOR
+  1, // HUE
+  1, // CLEAR
+  1, // FILL
+  4, // WAVE
+  2, // BLEND
+  2, // FADE
+  2, // SPARKLE
+  3  // HUESHIFT
+};
+
+// Same output as showColorWave() with a red wave
+const uint8_t vmColorWaveProgram[] = {
+  VM_COLOR, 255, 0, 0,
+  VM_WAVE, 0x0F, 0, 20, 30,
+  VM_ADD, 0, 1,
+  VM_MOD, 0, 45, 1,          // 301
+  VM_END
+};
+
+// Drifting rainbow with sparkles
+const uint8_t vmRainbowSparkleProgram[] = {
+  VM_HUESHIFT, 0x0F, 0, 3,
+  VM_ADD, 0, 2,
+  VM_SPARKLE, 30, 2,
+  VM_END
+};
+
+const uint8_t* const vmBuiltinPrograms[] = {vmColorWaveProgram, vmRainbowSparkleProgram};
+const uint8_t vmBuiltinLengths[] = {sizeof(vmColorWaveProgram), sizeof(vmRainbowSparkleProgram)};
+const int vmBuiltinCount = sizeof(vmBuiltinLengths) / sizeof(vmBuiltinLengths[0]);
+
+VMState vm = {vmColorWaveProgram, sizeof(vmColorWaveProgram), {0}, CRGB::White, {0}, {0}, 0};
+
+// Checks opcodes, operand lengths and register indices once at load time
+// so the interpreter doesn't have to on every frame
+bool validateVMProgram(const uint8_t* program, int length) {
+  int pc = 0;
+  while (pc < length) {
+    uint8_t opcode = program[pc];
+    if (opcode >= VM_OPCODE_COUNT) return false;
+    if (pc + vmOperandCount[opcode] >= length) return false;
+    
+    const uint8_t* args = &program[pc + 1];
+    switch (opcode) {
+      case VM_END:
+        return true;
+      case VM_SET:
+      case VM_ADD:
+      case VM_MOD:
+      case VM_HUE:
+        if (args[0] >= VM_REGISTER_COUNT) return false;
+        if (opcode == VM_MOD && ((args[1] == 0 && args[2] == 0) || (args[2] & 0x80))) return false; // Divisor must be positive
+        break;
+      case VM_WAVE:
+      case VM_HUESHIFT:
+        if (args[1] >= VM_REGISTER_COUNT) return false;
+        if (opcode == VM_WAVE && args[2] < VM_MIN_WAVE_WIDTH) return false; // Wave falloff divides by width / 2
+        break;
+    }
+    pc += 1 + vmOperandCount[opcode];
+  }
+  return false; // No END
+}
+
+bool loadVMProgram(const uint8_t* program, int length) {
+  if (!validateVMProgram(program, length)) {
+    Serial.println("⚠️ Invalid VM program");
+    return false;
+  }
+  vm.program = program;
+  vm.length = length;
+  resetVM();
+  return true;
+}
+
+bool loadBuiltinVMProgram(int index) {
+  if (index < 0 || index >= vmBuiltinCount) {
+    return false;
+  }
+  return loadVMProgram(vmBuiltinPrograms[index], vmBuiltinLengths[index]);
+}
+
+void clearLoadedVMProgram() {
+  vm.uploadLength = 0;
+}
+
+int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Appends hex bytes ("0401ff00") to the program being loaded over serial
+bool appendVMProgram(const char* hex) {
+  uint8_t length = vm.uploadLength;
+  
+  for (const char* p = hex; *p != '\0'; p += 2) {
+    int high = hexDigit(p[0]);
+    int low = (p[1] != '\0') ? hexDigit(p[1]) : -1;
+    if (high < 0 || low < 0 || length >= VM_PROGRAM_SIZE) {
+      return false;
+    }
+    vm.uploadProgram[length++] = (high << 4) | low;
+  }
+  
+  vm.uploadLength = length;
+  return true;
+}
+
+bool runLoadedVMProgram() {
+  // Uploads are staged, so editing one can't change the program the VM is running
+  if (!validateVMProgram(vm.uploadProgram, vm.uploadLength)) {
+    Serial.println("⚠️ Invalid VM program");
+    return false;
+  }
+  memcpy(vm.loadedProgram, vm.uploadProgram, vm.uploadLength);
+  vm.program = vm.loadedProgram;
+  vm.length = vm.uploadLength;
+  resetVM();
+  setLEDEffect(LED_VM_PROGRAM);
+  return true;
+}
+
+void resetVM() {
+  for (int i = 0; i < VM_REGISTER_COUNT; i++) {
+    vm.registers[i] = 0;
+  }
+  vm.color = CRGB::White;
+}
+
+void runVMFrame() {
+  const uint8_t* program = vm.program;
+  int pc = 0;
+  
+  while (pc < vm.length) {
+    const uint8_t* args = &program[pc + 1];
+    uint8_t opcode = program[pc];
+    pc += 1 + vmOperandCount[opcode];
+    
+    switch (opcode) {
+      case VM_END:
+        return;
+        
+      case VM_SET:
+        vm.registers[args[0]] = args[1] | (args[2] << 8);
+        break;
+        
+      case VM_ADD:
+        vm.registers[args[0]] += (int8_t)args[1];
+        break;
+        
+      case VM_MOD: {
+        int16_t divisor = args[1] | (args[2] << 8);
+        int16_t value = vm.registers[args[0]] % divisor;
+        vm.registers[args[0]] = (value < 0) ? value + divisor : value;
+        break;
+      }
+        
+      case VM_COLOR:
+        vm.color = CRGB(args[0], args[1], args[2]);
+        break;
+        
+      case VM_HUE: {
+        const RGBEntry &rgb = rainbowTable.values[vm.registers[args[0]] & 0xFF];
+        vm.color = CRGB(rgb.r, rgb.g, rgb.b);
+        break;
+      }
+        
+      case VM_CLEAR:
+        for (int section = 0; section < 4; section++) {
+          if (args[0] & (1 << section)) clearSection(section);
+        }
+        break;
+        
+      case VM_FILL:
+        for (int section = 0; section < 4; section++) {
+          if (args[0] & (1 << section)) fillSection(getSectionStart(section), getSectionEnd(section), vm.color);
+        }
+        break;
+        
+      case VM_WAVE:
+        for (int section = 0; section < 4; section++) {
+          if (!(args[0] & (1 << section))) continue;
+          int span = getSectionLength(section) + args[2];
+          int center = (vm.registers[args[1]] + section * args[3]) % span;
+          if (center < 0) center += span;
+          renderWaveSection(section, center, args[2], vm.color);
+        }
+        break;
+        
+      case VM_BLEND:
+        for (int section = 0; section < 4; section++) {
+          if (!(args[0] & (1 << section))) continue;
+          for (int i = getSectionStart(section); i <= getSectionEnd(section); i++) {
+            setSectionPixel(section, i, blendColors(leds[i], vm.color, args[1]));
+          }
+        }
+        break;
+        
+      case VM_FADE:
+        for (int section = 0; section < 4; section++) {
+          if (args[0] & (1 << section)) fadeSection(getSectionStart(section), getSectionEnd(section), args[1]);
+        }
+        break;
+        
+      case VM_SPARKLE:
+        for (int n = 0; n < args[1]; n++) {
+          if (effectRandomRange(100) < args[0]) {
+            setPixel(effectRandomRange(SECTION_4_END + 1), CRGB::White);
+          }
+        }
+        break;
+        
+      case VM_HUESHIFT:
+        for (int section = 0; section < 4; section++) {
+          if (!(args[0] & (1 << section))) continue;
+          uint8_t hue = vm.registers[args[1]];
+          for (int i = getSectionStart(section); i <= getSectionEnd(section); i++) {
+            const RGBEntry &rgb = rainbowTable.values[hue];
+            setSectionPixel(section, i, CRGB(rgb.r, rgb.g, rgb.b));
+            hue += args[2];
+          }
+        }
+        break;
+    }
+  }
+}
+
+// Renders the same wave with showColorWave's kernel and with the VM, without
+// sending frames to the strip, and reports the cost of each
+void benchmarkVM() {
+  VMState savedVM = vm;
+  LEDState savedState = ledState;
+  
+  clearAllSections();
+  ledState.waveColor = CRGB::Red;
+  ledState.wavePosition = 0;
+  unsigned long startTime = micros();
+  for (int frame = 0; frame < VM_BENCH_FRAMES; frame++) {
+    renderColorWave();
+  }
+  unsigned long nativeTime = micros() - startTime;
+  
+  clearAllSections();
+  loadBuiltinVMProgram(0);
+  startTime = micros();
+  for (int frame = 0; frame < VM_BENCH_FRAMES; frame++) {
+    runVMFrame();
+  }
+  unsigned long vmTime = micros() - startTime;
+  
+  vm = savedVM;
+  ledState = savedState;
+  clearAllSections();
+  redrawCurrentEffect();
+  
+  Serial.println("🧪 VM benchmark (color wave):");
+  Serial.print("Hand-written: ");
+  Serial.print(nativeTime / VM_BENCH_FRAMES);
+  Serial.println(" us/frame");
+  Serial.print("VM:           ");
+  Serial.print(vmTime / VM_BENCH_FRAMES);
+  Serial.println(" us/frame");
+  unsigned long speedPercent = (vmTime > 0) ? nativeTime * 100 / vmTime : 100;
+  Serial.print("VM speed: ");
+  Serial.print(speedPercent);
+  Serial.println("% of hand-written");
+  Serial.print((speedPercent >= VM_MIN_SPEED_PERCENT) ? "✅ PASS" : "❌ FAIL");
+  Serial.print(" - target ");
+  Serial.print(VM_MIN_SPEED_PERCENT);
+  Serial.println("%");
+}
@@ -0,0 +1,338 @@
+#include "diagnostics.h"
+#include "ir-controller.h"
+#include "led-controller.h"
+#include "settings.h"
+#include "serial-console.h"
+#include "match-stats.h"
+#include "animation-vm.h"
+
+// DRAM section bounds from the ESP32 linker script
+extern "C" {
+  extern uint8_t _data_start, _data_end, _bss_start, _bss_end;
+}
+
+LoopStats loopStats = {0, 0, 0, 0, 0};
+MemoryStats memoryStats = {0xFFFFFFFF, 0xFFFFFFFF};
+LatencyStats latencyStats = {{}, {}, 0, 0, 0, LATENCY_STAGES};
+
+void recordLoopTime(unsigned long loopMicros) {
+  loopStats.windowTotal += loopMicros;
+  loopStats.windowCount++;
+  if (loopMicros > loopStats.maxTime) {
+    loopStats.maxTime = loopMicros;
+  }
+  
+  if (loopStats.windowCount >= LOOP_STATS_WINDOW) {
+    loopStats.lastAverage = loopStats.windowTotal / loopStats.windowCount;
+    loopStats.windowTotal = 0;
+    loopStats.windowCount = 0;
+  }
+}
+
+void recordConsoleTime(unsigned long consoleMicros) {
+  if (consoleMicros > loopStats.consoleMaxTime) {
+    loopStats.consoleMaxTime = consoleMicros;
+  }
+}
+
+void resetLoopStats() {
+  loopStats.windowTotal = 0;
+  loopStats.windowCount = 0;
+  loopStats.lastAverage = 0;
+  loopStats.maxTime = 0;
+  loopStats.consoleMaxTime = 0;
+}
+
+void printLoopStats() {
+  Serial.println("⏱️ Loop timing:");
+  Serial.print("Average loop: ");
+  Serial.print(loopStats.lastAverage);
+  Serial.println(" us");
+  Serial.print("Longest loop: ");
+  Serial.print(loopStats.maxTime);
+  Serial.println(" us");
+  Serial.print("Longest console update: ");
+  Serial.print(loopStats.consoleMaxTime);
+  Serial.println(" us");
+}
+
+// Average render time per frame in microseconds. Frames are rendered into
+// the LED buffer only, never sent to the strip.
+unsigned long timeRender(void (*render)(), int frames) {
+  clearAllSections();
+  unsigned long startTime = micros();
+  for (int frame = 0; frame < frames; frame++) {
+    render();
+  }
+  return (micros() - startTime) / frames;
+}
+
+// The rainbow wave as it was before the lookup tables: a divide per pixel
+// for the hue and a CHSV conversion. Kept only as the benchmark baseline.
+void renderRainbowWaveReference() {
+  for (int section = 0; section < 4; section++) {
+    int sectionStart = getSectionStart(section);
+    int sectionLength = getSectionLength(section);
+    
+    int localWavePos = (ledState.wavePosition + section * 20) % (sectionLength + WAVE_WIDTH);
+    
+    int windowStart, windowEnd;
+    bool visible = getWaveWindow(section, localWavePos, WAVE_WIDTH, windowStart, windowEnd);
+    clearSectionOutside(section, windowStart, windowEnd);
+    if (!visible) continue;
+    
+    for (int i = windowStart; i <= windowEnd; i++) {
+      int localIndex = i - sectionStart;
+      uint8_t intensity = getWaveIntensity(localIndex, localWavePos, WAVE_WIDTH);
+      
+      CRGB color = CRGB::Black;
+      if (intensity > 0) {
+        uint8_t hue = (i * 255 / NUM_LEDS + ledState.wavePosition * 2) % 255;
+        color = CHSV(hue, 255, intensity);
+      }
+      setSectionPixel(section, i, color);
+    }
+  }
+  
+  ledState.wavePosition++;
+  if (ledState.wavePosition > 300) ledState.wavePosition = 0;
+}
+
+void benchmarkEffects() {
+  LEDState savedState = ledState;
+  ledState.wavePosition = 0;
+  
+  unsigned long colorWaveTime = timeRender(renderColorWave, EFFECT_BENCH_FRAMES);
+  ledState.wavePosition = 0;
+  unsigned long rainbowWaveTime = timeRender(renderRainbowWave, EFFECT_BENCH_FRAMES);
+  ledState.wavePosition = 0;
+  unsigned long referenceTime = timeRender(renderRainbowWaveReference, EFFECT_BENCH_FRAMES);
+  
+  ledState = savedState;
+  clearAllSections();
+  redrawCurrentEffect();
+  
+  Serial.println("🧪 Render benchmark:");
+  Serial.print("Color wave:   ");
+  Serial.print(colorWaveTime);
+  Serial.println(" us/frame");
+  Serial.print("Rainbow wave: ");
+  Serial.print(rainbowWaveTime);
+  Serial.println(" us/frame");
+  Serial.print("Rainbow (divide + CHSV): ");
+  Serial.print(referenceTime);
+  Serial.println(" us/frame");
+  
+  // Tenths, so a small gain doesn't round to 1x
+  unsigned long speedup = (rainbowWaveTime > 0) ? referenceTime * 10 / rainbowWaveTime : 0;
+  Serial.print("Lookup tables: ");
+  Serial.print(speedup / 10);
+  Serial.print(".");
+  Serial.print(speedup % 10);
+  Serial.println("x faster than divide + CHSV");
+}
+
+// ===========================================
+// GOAL-TO-LIGHT LATENCY
+// ===========================================
+
+// Called when the classifier accepts a goal. Beam times are on the sensor
+// sample clock (ms); the stages after the verdict are timed in microseconds.
+void beginGoalLatency(unsigned long breakTime, unsigned long clearTime, unsigned long verdictTime) {
+  GoalLatency &current = latencyStats.current;
+  current.blocked = clearTime - breakTime;
+  current.confirm = verdictTime - clearTime;
+  latencyStats.nextStage = LATENCY_VERDICT;
+  markGoalLatency(LATENCY_VERDICT);
+}
+
+// Stages only count in pipeline order, so frames unrelated to a goal are ignored
+void markGoalLatency(LatencyStage stage) {
+  if (stage != latencyStats.nextStage) {
+    return;
+  }
+  GoalLatency &current = latencyStats.current;
+  current.stageMicros[stage] = micros();
+  latencyStats.nextStage++;
+  if (stage != LATENCY_SHOWN) {
+    return;
+  }
+  
+  // The total runs from the beam break, which is when the player sees the
+  // goal. How long the ball sits in the beam is up to the ball, so only the
+  // time from the beam clearing is held to the budget.
+  current.controlled = current.confirm * 1000 +
+                       (current.stageMicros[LATENCY_SHOWN] - current.stageMicros[LATENCY_VERDICT]);
+  current.total = current.blocked * 1000 + current.controlled;
+  latencyStats.last = current;
+  latencyStats.measured++;
+  if (current.controlled > latencyStats.worstControlled) {
+    latencyStats.worstControlled = current.controlled;
+  }
+  if (current.controlled > settings.latencyBudget * 1000UL) {
+    latencyStats.overBudget++;
+    Serial.print("⏱️ Goal-to-light latency ");
+    Serial.print(current.controlled / 1000);
+    Serial.print(" ms after the beam cleared exceeds budget of ");
+    Serial.print(settings.latencyBudget);
+    Serial.println(" ms");
+  }
+}
+
+void printLatencyStage(const char* name, unsigned long value, const char* unit) {
+  Serial.print("  ");
+  Serial.print(name);
+  Serial.print(value);
+  Serial.println(unit);
+}
+
+void printGoalLatency(const GoalLatency &latency) {
+  const uint32_t* stage = latency.stageMicros;
+  printLatencyStage("Beam blocked:    ", latency.blocked, " ms");
+  printLatencyStage("Clear dwell:     ", latency.confirm, " ms");
+  printLatencyStage("Scoring:         ", stage[LATENCY_CELEBRATION] - stage[LATENCY_VERDICT], " us");
+  printLatencyStage("First frame:     ", stage[LATENCY_RENDERED] - stage[LATENCY_CELEBRATION], " us");
+  printLatencyStage("LED transfer:    ", stage[LATENCY_SHOWN] - stage[LATENCY_RENDERED], " us");
+  printLatencyStage("From beam clear: ", latency.controlled, " us");
+  printLatencyStage("Total:           ", latency.total, " us");
+}
+
+void printLatencyStats() {
+  Serial.println("⏱️ Goal-to-light latency:");
+  if (latencyStats.measured == 0) {
+    Serial.println("No goals measured yet - try 'bench goal'");
+    return;
+  }
+  printGoalLatency(latencyStats.last);
+  Serial.print("Worst from beam clear: ");
+  Serial.print(latencyStats.worstControlled);
+  Serial.print(" us | goals: ");
+  Serial.print(latencyStats.measured);
+  Serial.print(" | over budget: ");
+  Serial.print(latencyStats.overBudget);
+  Serial.print(" | budget: ");
+  Serial.print(settings.latencyBudget);
+  Serial.println(" ms");
+}
+
+// Injects a goal on Goal 1 at a known virtual time and runs it through the
+// real detection, scoring and celebration code until the first frame is
+// shown. Score, match stats and sensor state are restored afterwards.
+void benchmarkGoalLatency() {
+  if (isCelebrationActive() || !isGameActive()) {
+    Serial.println("⚠️ Goal benchmark needs an active game and no celebration running");
+    return;
+  }
+  
+  uint8_t savedScoreA = scoreTeamA;
+  uint8_t savedScoreB = scoreTeamB;
+  MatchStats savedMatchStats = matchStats;
+  DetectionState savedDetection = detection;
+  LatencyStats savedLatency = latencyStats;
+  
+  // From 0-0 the injected goal can't end the game
+  scoreTeamA = 0;
+  scoreTeamB = 0;
+  
+  GoalSensor &sensor = detection.sensors[0];
+  unsigned long breakTime = millis();
+  sensor.lastTriggerTime = breakTime - settings.irDebounceTime - 1;
+  resetBeamClassifier(sensor.classifier);
+  resetSensorHealth(sensor.health, breakTime);
+  
+  // Ball blocks the beam like a typical goal (never less than a goal needs),
+  // then the beam stays clear
+  unsigned long minBlockTime = max((unsigned long)settings.irBlockedThreshold, 2UL) * IR_SAMPLE_INTERVAL;
+  unsigned long blockTime = max((unsigned long)GOAL_LATENCY_BENCH_BLOCK, minBlockTime);
+  unsigned long now = breakTime;
+  for (; now - breakTime < blockTime; now += IR_SAMPLE_INTERVAL) {
+    updateGoalSensor(0, true, now);
+  }
+  unsigned long deadline = now + settings.goalClearDwell + 2 * IR_SAMPLE_INTERVAL;
+  uint16_t measuredBefore = latencyStats.measured;
+  for (; now <= deadline && latencyStats.measured == measuredBefore; now += IR_SAMPLE_INTERVAL) {
+    updateGoalSensor(0, false, now);
+  }
+  
+  bool measured = (latencyStats.measured != measuredBefore);
+  GoalLatency result = latencyStats.last;
+  
+  clearCelebrationQueue();
+  endCelebration();
+  scoreTeamA = savedScoreA;
+  scoreTeamB = savedScoreB;
+  matchStats = savedMatchStats;
+  detection = savedDetection;
+  latencyStats = savedLatency;
+  
+  Serial.println("🧪 Goal-to-light benchmark (Goal 1):");
+  if (!measured) {
+    Serial.println("❌ FAIL - injected goal never reached the strip");
+    return;
+  }
+  printGoalLatency(result);
+  Serial.print((result.controlled <= settings.latencyBudget * 1000UL) ? "✅ PASS" : "❌ FAIL");
+  Serial.print(" - budget ");
+  Serial.print(settings.latencyBudget);
+  Serial.println(" ms from beam clear");
+}
+
+// Sampled from the loop task, so the stack figure is the loop task's headroom
+void updateMemoryStats() {
+  uint32_t freeHeap = ESP.getMinFreeHeap();
+  if (freeHeap < memoryStats.minFreeHeap) {
+    memoryStats.minFreeHeap = freeHeap;
+  }
+  
+  uint32_t stackHeadroom = uxTaskGetStackHighWaterMark(NULL);
+  if (stackHeadroom < memoryStats.minStackHeadroom) {
+    memoryStats.minStackHeadroom = stackHeadroom;
+  }
+}
+
+void printStaticSize(const char* name, size_t bytes) {
+  Serial.print("  ");
+  Serial.print(name);
+  Serial.print(": ");
+  Serial.print((unsigned long)bytes);
+  Serial.println(" B");
+}
+
+void printMemoryReport() {
+  updateMemoryStats();
+  
+  // Whole firmware, including the Arduino core and libraries
+  size_t dataSize = &_data_end - &_data_start;
+  size_t bssSize = &_bss_end - &_bss_start;
+  
+  Serial.println("🧠 Memory:");
+  Serial.println("Static RAM (linker sections):");
+  printStaticSize(".data", dataSize);
+  printStaticSize(".bss", bssSize);
+  printStaticSize("Total", dataSize + bssSize);
+  
+  Serial.println("Largest firmware state:");
+  printStaticSize("LED buffer", sizeof(CRGB) * NUM_LEDS);
+  printStaticSize("Effect state", sizeof(LEDState));
+  printStaticSize("Celebrations", sizeof(CelebrationState));
+  printStaticSize("Dirty tracking", sizeof(FrameState));
+  printStaticSize("Fault overlay", sizeof(FaultOverlay));
+  printStaticSize("Power governor", sizeof(PowerState));
+  printStaticSize("Animation VM", sizeof(VMState));
+  printStaticSize("Goal detection", sizeof(DetectionState));
+  printStaticSize("Settings", sizeof(Settings));
+  printStaticSize("Console", sizeof(ConsoleState));
+  printStaticSize("Match stats", sizeof(MatchStats));
+  printStaticSize("Diagnostics", sizeof(LoopStats) + sizeof(MemoryStats) + sizeof(LatencyStats));
+  
+  Serial.print("Loop stack headroom (min): ");
+  Serial.print(memoryStats.minStackHeadroom);
+  Serial.println(" B");
+  Serial.print("Heap free: ");
+  Serial.print(ESP.getFreeHeap());
+  Serial.print(" B | min: ");
+  Serial.print(memoryStats.minFreeHeap);
+  Serial.print(" B | largest block: ");
+  Serial.print(ESP.getMaxAllocHeap());
+  Serial.println(" B");
+}
@@ -0,0 +1,120 @@
+#include "goal-classifier.h"
+#include "ir-controller.h"
+#include "settings.h"
+
+void resetBeamClassifier(BeamClassifier &classifier) {
+  memset(&classifier, 0, sizeof(classifier));
+}
+
+void recordBeamInterval(BeamClassifier &classifier, uint32_t start, uint16_t duration) {
+  classifier.history[classifier.historyHead].start = start;
+  classifier.history[classifier.historyHead].duration = duration;
+  classifier.historyHead = (classifier.historyHead + 1) % BEAM_HISTORY_SIZE;
+  if (classifier.historyCount < BEAM_HISTORY_SIZE) {
+    classifier.historyCount++;
+  }
+}
+
+// Bounded by BEAM_HISTORY_SIZE, so constant time per call
+uint8_t countRecentBreaks(const BeamClassifier &classifier, unsigned long now, unsigned long window) {
+  uint8_t count = 0;
+  for (int i = 0; i < classifier.historyCount; i++) {
+    if (now - classifier.history[i].start <= window) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Feed one sample; returns a verdict once an event is complete. Constant time.
+BeamVerdict classifyBeamSample(BeamClassifier &classifier, bool blocked, unsigned long now) {
+  BeamFeatures &features = classifier.features;
+  
+  if (blocked) {
+    if (!classifier.blocked) {
+      // Beam just broke - start a new event or add a re-break to the current one
+      classifier.blocked = true;
+      classifier.blockStart = now;
+      if (!classifier.pending) {
+        classifier.pending = true;
+        classifier.reported = false;
+        classifier.eventStart = now;
+        memset(&features, 0, sizeof(features));
+      }
+      if (features.breaks < 255) features.breaks++;
+    }
+    
+    // Dwelling in the beam: reject right away rather than waiting for it to clear
+    unsigned long blockTime = now - classifier.blockStart;
+    if (!classifier.reported && blockTime > settings.goalMaxBlockTime) {
+      classifier.reported = true;
+      features.longestBlock = min(blockTime, 0xFFFFUL);
+      features.rebreaks = countRecentBreaks(classifier, now, settings.goalRebreakWindow) + 1;
+      return BEAM_REJECT_LONG;
+    }
+    return BEAM_NONE;
+  }
+  
+  if (classifier.blocked) {
+    // Beam just cleared - close the interval
+    classifier.blocked = false;
+    classifier.lastClear = now;
+    uint16_t duration = min(now - classifier.blockStart, 0xFFFFUL);
+    recordBeamInterval(classifier, classifier.blockStart, duration);
+    if (duration > features.longestBlock) features.longestBlock = duration;
+    features.totalBlocked = min((unsigned long)features.totalBlocked + duration, 0xFFFFUL);
+    return BEAM_NONE;
+  }
+  
+  // Clear long enough - classify the event
+  if (!classifier.pending || now - classifier.lastClear < settings.goalClearDwell) {
+    return BEAM_NONE;
+  }
+  classifier.pending = false;
+  if (classifier.reported) {
+    return BEAM_NONE;
+  }
+  
+  features.rebreaks = countRecentBreaks(classifier, now, settings.goalRebreakWindow);
+  unsigned long minBlockTime = (unsigned long)settings.irBlockedThreshold * IR_SAMPLE_INTERVAL;
+  
+  if (features.breaks == 1 && features.longestBlock <= IR_SAMPLE_INTERVAL && minBlockTime > IR_SAMPLE_INTERVAL) {
+    return BEAM_NOISE;
+  }
+  if (features.longestBlock < minBlockTime) {
+    return BEAM_REJECT_SHORT;
+  }
+  if (features.longestBlock > settings.goalMaxBlockTime) {
+    return BEAM_REJECT_LONG;
+  }
+  if (features.rebreaks > settings.goalMaxRebreaks) {
+    return BEAM_REJECT_REBREAK;
+  }
+  return BEAM_GOAL;
+}
+
+const char* getBeamVerdictName(BeamVerdict verdict) {
+  switch (verdict) {
+    case BEAM_GOAL:           return "goal";
+    case BEAM_NOISE:          return "noise";
+    case BEAM_REJECT_SHORT:   return "too short";
+    case BEAM_REJECT_LONG:    return "too long";
+    case BEAM_REJECT_REBREAK: return "rattle";
+    default:                  return "none";
+  }
+}
+
+void printBeamEvent(const char* goalName, BeamVerdict verdict, const BeamFeatures &features) {
+  Serial.print((verdict == BEAM_GOAL) ? "✅ Beam event " : "🚫 Rejected beam event ");
+  Serial.print(goalName);
+  Serial.print(": ");
+  Serial.print(getBeamVerdictName(verdict));
+  Serial.print(" | longest block ");
+  Serial.print(features.longestBlock);
+  Serial.print(" ms, total ");
+  Serial.print(features.totalBlocked);
+  Serial.print(" ms, breaks ");
+  Serial.print(features.breaks);
+  Serial.print(", in window ");
+  Serial.println(features.rebreaks);
+}
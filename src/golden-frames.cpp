@@ -0,0 +1,278 @@
+#include "golden-frames.h"
+#include "ir-controller.h"
+#include "animation-vm.h"
+
+#define GOLDEN_VM_PROGRAM 1        // Built-in rainbow sparkle, exercises most VM ops
+
+const char* const goldenEffectNames[GOLDEN_EFFECT_COUNT] = {
+  "off", "white", "wave", "rainbow", "breathing", "vm",
+  "goal A", "goal B", "win A", "win B"
+};
+
+// Regenerate with 'golden table' after an intended change to an effect
+const uint32_t goldenFrameCRCs[GOLDEN_EFFECT_COUNT][GOLDEN_FRAMES] = {
+  { // off
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663,
+    0x00ECE663, 0x00ECE663, 0x00ECE663, 0x00ECE663
+  },
+  { // white
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B,
+    0x226B4F3B, 0x226B4F3B, 0x226B4F3B, 0x226B4F3B
+  },
+  { // wave
+    0x0A51EDF9, 0x04EFBA7A, 0x34CDF621, 0xCDB8ED7A,
+    0x4AE4FC46, 0xCF3293DB, 0x7FC77393, 0x412280EB,
+    0x8FDB6B2D, 0x150A3C36, 0x463168CD, 0x97668FFD,
+    0x1EF5AB1E, 0x5A0985C7, 0x9EFB2D25, 0x5B1D3CDF,
+    0xE4C2E3CF, 0x3512FF1D, 0x5F23A797, 0x2225D9A6,
+    0xD338F3B9, 0x5717E653, 0x44512052, 0xFAEFCDBC,
+    0xAD285583, 0xAE5156F2, 0x98E47D4D, 0x91B75B49,
+    0xD0D7807A, 0x917E138B, 0x367C8016, 0x1309CBD1
+  },
+  { // rainbow
+    0x82BDD8E0, 0x9A4DFEE9, 0x06189B9D, 0x6BAC00FE,
+    0x01F8A699, 0x051003CC, 0x2F6961FE, 0x59E22699,
+    0x3004BE22, 0x388A3F20, 0x457BC18E, 0x86C32BC5,
+    0x824FE0D0, 0x6D3E2D59, 0x754B06F6, 0x2A08CBB7,
+    0x9DBFECD1, 0xDC281B2B, 0x6A2D45E6, 0x02E09EDC,
+    0x50E3F084, 0xE58D03F6, 0xCCF9EF3E, 0x8E4B1E51,
+    0xC1946AD9, 0x49667151, 0x96DCC47D, 0xB9E7E7CC,
+    0xFDE31C68, 0x16C90EF1, 0x5EE0B136, 0x00C1ABAB
+  },
+  { // breathing
+    0x15B374CB, 0x15B374CB, 0x15B374CB, 0x15B374CB,
+    0x15B374CB, 0x15B374CB, 0x15B374CB, 0x15B374CB,
+    0x15B374CB, 0x15B374CB, 0x15B374CB, 0x62B4445D,
+    0x62B4445D, 0x62B4445D, 0xFBBD15E7, 0xFBBD15E7,
+    0xFBBD15E7, 0x8CBA2571, 0x8CBA2571, 0x1C0538E0,
+    0x1C0538E0, 0x6B020876, 0x6B020876, 0xF20B59CC,
+    0x850C695A, 0x850C695A, 0x1B68FCF9, 0x6C6FCC6F,
+    0x6C6FCC6F, 0xF5669DD5, 0x8261AD43, 0x8261AD43
+  },
+  { // vm
+    0x0FCD923E, 0x2EE1FDA6, 0x2D72962E, 0x10C68D42,
+    0x95741E57, 0x2E214EAE, 0x94F7B0A5, 0xFDA61C37,
+    0xC88D9A7B, 0xAB7DDD92, 0x9CC61229, 0x1A7F924F,
+    0x9F105431, 0x85276052, 0x4B73304F, 0x1F55F773,
+    0x42B0D1ED, 0xAFD9015A, 0xC9AB873E, 0x95CC52DC,
+    0x8463038E, 0xB52BBA8D, 0x57FD68A8, 0x9A04E85E,
+    0x24823AA7, 0x93038C44, 0xBA7303C8, 0x0B00FA48,
+    0xCF8F614F, 0x5C394D39, 0xF4738C5C, 0x5C6D2119
+  },
+  { // goal A
+    0xFF01202F, 0x166B5931, 0xE8F33C49, 0xFE12C573,
+    0x5929103E, 0x5A6E520B, 0x09AFF56E, 0x22F2542E,
+    0xD888A77E, 0x4E542E49, 0xCEABE3D4, 0x94321DFA,
+    0xE40ACE35, 0xA0A2CD9D, 0x8DC09A46, 0x3225EC3F,
+    0x86C74B1C, 0xA08F8CB5, 0xEF05D11E, 0xD48C3769,
+    0x58FFCA91, 0xB384002A, 0x893FA530, 0x970805F2,
+    0xD6E5B6B5, 0x64ABC2F5, 0xEEEDB9E5, 0x2C6F2753,
+    0x991965D5, 0xC21D5794, 0xE11BDFED, 0xB3F31DC8
+  },
+  { // goal B
+    0xBDCEC392, 0x0D77C786, 0xBF422ACA, 0x2699F461,
+    0xBB3A006C, 0xC622DE59, 0x875A488E, 0xEF2C0E8D,
+    0xA18A3FFE, 0xD8DEB6B9, 0xA7D4EAB5, 0x7174FE40,
+    0x1493172F, 0xC3BCE869, 0x524D2BA6, 0x72AE5E16,
+    0xEC4D5144, 0xEF1D85FE, 0xD45FC770, 0x8D2C6084,
+    0xF39B3A36, 0x8B2127EB, 0xE558B48A, 0xB94BE955,
+    0xDEB01912, 0x6E0058C0, 0x6B1AD6D1, 0x9E1D7C87,
+    0x4C759370, 0x060B23A7, 0xC09E47AC, 0x15510D19
+  },
+  { // win A
+    0x8A52B503, 0x02730A68, 0x445AFEF9, 0x4075435A,
+    0x43F6AC90, 0x45F1C355, 0x07F6E0D7, 0xB5EE37BA,
+    0x39B812CC, 0xDAB77E79, 0xE46AA899, 0x78E86F2A,
+    0x4737B970, 0xCCEB727D, 0xB8DC573E, 0x9909166F,
+    0xF43C94FB, 0x46EC7106, 0x2435B226, 0x489A38FC,
+    0x1400E2E4, 0x12B70CFD, 0x50C0A87D, 0x193BF290,
+    0x59FFDBEE, 0x8586F321, 0x9BC82FAF, 0x5DBD073E,
+    0xC0BEEE72, 0x3F3DA821, 0xCE548DC3, 0xD730789D
+  },
+  { // win B
+    0x6D81E5F0, 0xB817AB0A, 0x4CFE75E3, 0x024DAD33,
+    0xF56BCB3A, 0xE1D6551E, 0x1BE35CF6, 0x6F26CC96,
+    0x618E1623, 0x1EE9C8F9, 0xBE33D383, 0xF26EBD65,
+    0x560D4A9B, 0x0C6D0D09, 0x49CB4F41, 0xCB986262,
+    0x47C98078, 0xE9FA5B29, 0x218F9CBE, 0xA52D9A94,
+    0x550799D3, 0x94915974, 0x987F6008, 0xBCBCA8C3,
+    0x6FFFC6D0, 0xF0AF28F6, 0x863ECF99, 0x4CB0737E,
+    0x08996814, 0x4BE2EE2A, 0xDEC45965, 0x959ACA40
+  }
+};
+
+const char* getGoldenEffectName(int effect) {
+  return (effect >= 0 && effect < GOLDEN_EFFECT_COUNT) ? goldenEffectNames[effect] : "?";
+}
+
+// Puts an effect in its golden starting state: cleared strip, fixed seed,
+// colors and brightness
+void beginGoldenEffect(LEDEffect effect) {
+  clearAllSections();
+  setEffectRandomSeed(GOLDEN_SEED);
+  ledState.currentEffect = effect;
+  ledState.wavePosition = 0;
+  ledState.breathingPhase = 0;
+  ledState.waveColor = CRGB::Red;
+  bool teamA = (effect == LED_GOAL_CELEBRATION_A || effect == LED_GAME_WIN_CELEBRATION_A);
+  celebration.color = teamA ? TEAM_A_COLOR : TEAM_B_COLOR;
+  if (effect == LED_VM_PROGRAM) {
+    loadBuiltinVMProgram(GOLDEN_VM_PROGRAM);
+  }
+  applyBrightness(GOLDEN_BRIGHTNESS);
+}
+
+// Renders one frame of an effect into leds[] and returns its CRC. Nothing is
+// sent to the strip, and the pacing done by updateLEDs is skipped.
+uint32_t renderGoldenFrame(LEDEffect effect, int frameIndex) {
+  ledState.frameTime = (uint32_t)frameIndex * GOLDEN_FRAME_INTERVAL;
+  switch (effect) {
+    case LED_OFF:
+      clearAllSections();
+      break;
+    case LED_FULL_WHITE:
+      renderFullWhite();
+      break;
+    case LED_COLOR_WAVE:
+      renderColorWave();
+      break;
+    case LED_RAINBOW_WAVE:
+      renderRainbowWave();
+      break;
+    case LED_BREATHING:
+      renderBreathing();
+      break;
+    case LED_VM_PROGRAM:
+      runVMFrame();
+      break;
+    case LED_GOAL_CELEBRATION_A:
+    case LED_GOAL_CELEBRATION_B:
+      renderGoalCelebration();
+      break;
+    case LED_GAME_WIN_CELEBRATION_A:
+    case LED_GAME_WIN_CELEBRATION_B:
+      renderGameWinCelebration();
+      break;
+  }
+  return getFrameChecksum();
+}
+
+void printCRC(uint32_t crc) {
+  Serial.print("0x");
+  for (int shift = 28; shift >= 0; shift -= 4) {
+    Serial.print((crc >> shift) & 0xF, HEX);
+  }
+}
+
+// Renders GOLDEN_FRAMES frames of one effect and compares each frame's CRC
+// with the table. With dumpMismatch the first mismatching frame is dumped as
+// PPM; everything else is only counted to keep the output short.
+bool checkGoldenEffect(LEDEffect effect, bool printTable, bool dumpMismatch) {
+  beginGoldenEffect(effect);
+  
+  if (printTable) {
+    Serial.print("  { // ");
+    Serial.println(getGoldenEffectName(effect));
+  }
+  
+  int mismatches = 0;
+  for (int i = 0; i < GOLDEN_FRAMES; i++) {
+    uint32_t crc = renderGoldenFrame(effect, i);
+  
+    if (printTable) {
+      Serial.print((i % 4 == 0) ? "    " : " ");
+      printCRC(crc);
+      Serial.print(",");
+      if (i % 4 == 3) Serial.println();
+      continue;
+    }
+  
+    uint32_t expected = goldenFrameCRCs[effect][i];
+    if (crc == expected) continue;
+    if (mismatches == 0) {
+      Serial.print("❌ ");
+      Serial.print(getGoldenEffectName(effect));
+      Serial.print(" frame ");
+      Serial.print(i);
+      Serial.print(": expected ");
+      printCRC(expected);
+      Serial.print(", got ");
+      printCRC(crc);
+      Serial.println();
+      if (dumpMismatch) dumpFrame();
+    }
+    mismatches++;
+  }
+  
+  if (printTable) {
+    Serial.println("  },");
+    return true;
+  }
+  Serial.print((mismatches == 0) ? "✅ " : "❌ ");
+  Serial.print(getGoldenEffectName(effect));
+  Serial.print(": ");
+  Serial.print(GOLDEN_FRAMES - mismatches);
+  Serial.print("/");
+  Serial.print(GOLDEN_FRAMES);
+  Serial.println(" frames match");
+  return mismatches == 0;
+}
+
+// Runs every effect against the golden table, or prints a new table. Frames
+// are only rendered into leds[], never shown, so the strip and the power
+// governor are left alone. Seed, clock and brightness are held fixed.
+bool runGoldenFrames(bool printTable) {
+  // The loop is busy for the whole run, so goals would go unseen
+  if (isCelebrationActive() || (isGameActive() && (scoreTeamA > 0 || scoreTeamB > 0))) {
+    Serial.println("⚠️ Golden frame check needs no game in progress - reset first");
+    return false;
+  }
+  
+  LEDState savedState = ledState;
+  CelebrationState savedCelebration = celebration;
+  VMState savedVM = vm;
+  uint8_t savedBrightness = power.requestedBrightness;
+  CRGB savedFrame[SECTION_4_END + 1];
+  memcpy(savedFrame, leds, sizeof(savedFrame));
+  
+  if (printTable) {
+    Serial.println("// Paste into goldenFrameCRCs in golden-frames.cpp");
+  } else {
+    Serial.println("🧪 Golden frames:");
+  }
+  bool passed = true;
+  for (int effect = 0; effect < GOLDEN_EFFECT_COUNT; effect++) {
+    // Only the first failing frame of the run is dumped
+    if (!checkGoldenEffect((LEDEffect)effect, printTable, passed)) {
+      passed = false;
+    }
+  }
+  
+  ledState = savedState;
+  celebration = savedCelebration;
+  vm = savedVM;
+  
+  // Put back the frame that is still on the strip
+  clearAllSections();
+  for (int i = 0; i <= SECTION_4_END; i++) {
+    setPixel(i, savedFrame[i]);
+  }
+  applyBrightness(savedBrightness);
+  
+  if (!printTable) {
+    Serial.println(passed ? "✅ PASS - all effects match" : "❌ FAIL - see mismatching frames above");
+  }
+  return passed;
+}
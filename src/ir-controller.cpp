@@ -1,20 +1,15 @@
 #include "ir-controller.h"
 #include "led-controller.h" 
+#include "settings.h"
+#include "match-stats.h"
+#include "diagnostics.h"
 
 // Score and game state variables
-int scoreTeamA = 0;
-int scoreTeamB = 0;
+uint8_t scoreTeamA = 0;
+uint8_t scoreTeamB = 0;
 GameState currentGameState = GAME_ACTIVE;
 
-unsigned long lastGoalTime = 0;
-unsigned long lastSensorCheck = 0;
-bool goal1Blocked = false;
-bool goal2Blocked = false;
-int goal1BlockedCount = 0;
-int goal2BlockedCount = 0;
-
-unsigned long lastGoal1TriggerTime = 0;
-unsigned long lastGoal2TriggerTime = 0;
+DetectionState detection = {};
 
 void initIRSensors() {
   Serial.println("Initializing IR sensors for goal detection...");
@@ -22,6 +17,10 @@ void initIRSensors() {
   pinMode(IR_SENSOR_GOAL_1_PIN, INPUT_PULLUP);
   pinMode(IR_SENSOR_GOAL_2_PIN, INPUT_PULLUP);
   
+  // Sensor health survives game restarts, so it is only reset here
+  resetSensorHealth(detection.sensors[0].health, millis());
+  resetSensorHealth(detection.sensors[1].health, millis());
+  
   startNewGame(); // Initialize new game
   
   Serial.println("IR sensors initialized:");
@@ -29,58 +28,112 @@ void initIRSensors() {
   Serial.println(IR_SENSOR_GOAL_1_PIN);
   Serial.print("- Goal 2 (Team B) sensor on pin ");
   Serial.println(IR_SENSOR_GOAL_2_PIN);
-  Serial.println("⚽ Soccer table ready for 10-point games! ⚽");
+  Serial.print("⚽ Soccer table ready for ");
+  Serial.print(settings.pointsToWin);
+  Serial.println("-point games! ⚽");
   printGameStatus();
 }
 
 void updateIRSensors() {
   unsigned long currentTime = millis();
   
-  if (currentTime - lastSensorCheck < 10) {
+  if (currentTime - detection.lastSensorCheck < IR_SAMPLE_INTERVAL) {
     return;
   }
-  lastSensorCheck = currentTime;
+  detection.lastSensorCheck = currentTime;
   
   bool sensor1Triggered = !readIRSensor(IR_SENSOR_GOAL_1_PIN); // Inverted because of pull-up
   bool sensor2Triggered = !readIRSensor(IR_SENSOR_GOAL_2_PIN); // Inverted because of pull-up
   
-  // Goal 1 (Team A) detection with debouncing
-  if (sensor1Triggered) {
-    goal1BlockedCount++;
-    if (goal1BlockedCount >= IR_BLOCKED_THRESHOLD && !goal1Blocked) {
-      // Check debounce time
-      if (currentTime - lastGoal1TriggerTime > IR_DEBOUNCE_TIME) {
-        goal1Blocked = true;
-        lastGoal1TriggerTime = currentTime;
-        onGoalScored(TEAM_A);
-      }
-    }
-  } else {
-    goal1BlockedCount = 0;
-    if (goal1Blocked && currentTime - lastGoal1TriggerTime > 1000) {
-      goal1Blocked = false; 
-    }
+  updateGoalSensor(0, sensor1Triggered, currentTime);
+  updateGoalSensor(1, sensor2Triggered, currentTime);
+}
+
+// Goal detection for one sensor: classify the beam signature, then debounce
+void updateGoalSensor(int index, bool triggered, unsigned long currentTime) {
+  GoalSensor &sensor = detection.sensors[index];
+  Team team = (index == 0) ? TEAM_A : TEAM_B;
+  
+  // Health first: a stuck or flickering beam is taken out of goal detection
+  // while the other goal keeps scoring
+  unsigned long otherLastBreak = detection.sensors[1 - index].health.lastBreak;
+  if (updateSensorHealth(sensor.health, triggered, otherLastBreak, currentTime)) {
+    onSensorHealthChanged(team, sensor.health.health);
+  }
+  if (!canSensorScore(sensor.health)) {
+    resetBeamClassifier(sensor.classifier);
+    return;
+  }
+  
+  BeamVerdict verdict = classifyBeamSample(sensor.classifier, triggered, currentTime);
+  
+  if (verdict == BEAM_NONE || verdict == BEAM_NOISE) {
+    return;
+  }
+  if (verdict != BEAM_GOAL) {
+    printBeamEvent(getGoalName(team), verdict, sensor.classifier.features);
+    return;
+  }
+  
+  // Check debounce time
+  if (currentTime - sensor.lastTriggerTime > settings.irDebounceTime) {
+    sensor.lastTriggerTime = currentTime;
+    beginGoalLatency(sensor.classifier.eventStart, sensor.classifier.lastClear, currentTime);
+    onGoalScored(team);
+  }
+}
+
+void onSensorHealthChanged(Team team, SensorHealth health) {
+  Serial.print((health == SENSOR_OK) ? "✅ " : "🩺 ");
+  Serial.print(getGoalName(team));
+  Serial.print(" sensor health: ");
+  Serial.println(getSensorHealthName(health));
+  
+  if (health == SENSOR_STUCK_BLOCKED || health == SENSOR_FLICKERING) {
+    Serial.println("Goal detection paused for this goal - the other goal keeps scoring");
   }
   
-  // Goal 2 (Team B) detection with debouncing
-  if (sensor2Triggered) {
-    goal2BlockedCount++;
-    if (goal2BlockedCount >= IR_BLOCKED_THRESHOLD && !goal2Blocked) {
-      // Check debounce time
-      if (currentTime - lastGoal2TriggerTime > IR_DEBOUNCE_TIME) {
-        goal2Blocked = true;
-        lastGoal2TriggerTime = currentTime;
-        onGoalScored(TEAM_B);
-      }
-    }
-  } else {
-    goal2BlockedCount = 0;
-    if (goal2Blocked && currentTime - lastGoal2TriggerTime > 1000) {
-      goal2Blocked = false; 
-    }
+  // Diagnostic pattern on the LED section along the affected goal
+  int section = (team == TEAM_A) ? GOAL_1_SECTION : GOAL_2_SECTION;
+  switch (health) {
+    case SENSOR_OK:
+      setSectionFault(section, false, CRGB::Black);
+      break;
+    case SENSOR_STUCK_BLOCKED:
+      setSectionFault(section, true, CRGB::Red);
+      break;
+    case SENSOR_STUCK_CLEAR:
+      setSectionFault(section, true, CRGB::Blue);
+      break;
+    case SENSOR_FLICKERING:
+      setSectionFault(section, true, CRGB::Purple);
+      break;
   }
 }
 
+void printSensorStatus() {
+  unsigned long now = millis();
+  
+  Serial.println("🩺 Sensors:");
+  for (int i = 0; i < 2; i++) {
+    const SensorHealthState &health = detection.sensors[i].health;
+    Serial.print(getGoalName((i == 0) ? TEAM_A : TEAM_B));
+    Serial.print(": ");
+    Serial.print(getSensorHealthName(health.health));
+    Serial.print(" | flicker ");
+    Serial.print(health.flickerRate);
+    Serial.print("/s | last break ");
+    Serial.print((now - health.lastBreak) / 1000);
+    Serial.print(" s ago | last good ");
+    Serial.print((now - health.lastGood) / 1000);
+    Serial.println(" s ago");
+  }
+}
+
+const char* getGoalName(Team team) {
+  return (team == TEAM_A) ? "Goal 1 (Team A)" : "Goal 2 (Team B)";
+}
+
 GoalEvent checkForGoal() {
   GoalEvent event;
   event.isValid = false;
@@ -88,7 +141,7 @@ GoalEvent checkForGoal() {
   unsigned long currentTime = millis();
   
   // Check if enough time has passed since last goal
-  if (currentTime - lastGoalTime < IR_DEBOUNCE_TIME) {
+  if (currentTime - detection.lastGoalTime < settings.irDebounceTime) {
     return event;
   }
   
@@ -97,7 +150,7 @@ GoalEvent checkForGoal() {
     event.team = TEAM_A;
     event.timestamp = currentTime;
     event.isValid = true;
-    lastGoalTime = currentTime;
+    detection.lastGoalTime = currentTime;
     return event;
   }
   
@@ -106,7 +159,7 @@ GoalEvent checkForGoal() {
     event.team = TEAM_B;
     event.timestamp = currentTime;
     event.isValid = true;
-    lastGoalTime = currentTime;
+    detection.lastGoalTime = currentTime;
     return event;
   }
   
@@ -119,13 +172,11 @@ bool isGoalDetected(int sensorPin) {
 }
 
 void resetGoalDetection() {
-  lastGoalTime = 0;
-  goal1Blocked = false;
-  goal2Blocked = false;
-  goal1BlockedCount = 0;
-  goal2BlockedCount = 0;
-  lastGoal1TriggerTime = 0;
-  lastGoal2TriggerTime = 0;
+  detection.lastGoalTime = 0;
+  for (int i = 0; i < 2; i++) {
+    detection.sensors[i].lastTriggerTime = 0;
+    resetBeamClassifier(detection.sensors[i].classifier);
+  }
 }
 
 void onGoalScored(Team team) {
@@ -135,31 +186,37 @@ void onGoalScored(Team team) {
     return;
   }
   
-  Serial.println("🥅 GOAL SCORED! 🥅");
+  // Update live match statistics
+  GoalEvent event;
+  event.team = team;
+  event.timestamp = millis();
+  event.isValid = true;
+  recordGoalEvent(event);
   
   // Increment score (this will also check for game end)
   incrementScore(team);
   
-  // Print goal information
-  Serial.print("Team ");
-  Serial.print((team == TEAM_A) ? "A (YELLOW)" : "B (ORANGE)");
-  Serial.println(" scored!");
-  printScore();
-  
   // Only trigger goal celebration if game is still active
   // (if game ended, the game win celebration will be triggered instead)
   if (isGameActive()) {
     celebrateGoal(team);
   }
+  
+  // Serial output can block once the UART buffer fills, so it comes after
+  // the celebration is already on the strip
+  Serial.println("🥅 GOAL SCORED! 🥅");
+  Serial.print("Team ");
+  Serial.print((team == TEAM_A) ? "A (YELLOW)" : "B (ORANGE)");
+  Serial.println(" scored!");
+  printScore();
 }
 
 void celebrateGoal(Team team) {
-  // Trigger LED celebration wave with team colors
-  Serial.print("🎉 Celebrating goal for Team ");
-  Serial.println((team == TEAM_A) ? "A" : "B");
-  
   // Trigger LED celebration (1 = Team A, 2 = Team B)
   triggerGoalCelebration((team == TEAM_A) ? 1 : 2);
+  
+  Serial.print("🎉 Celebrating goal for Team ");
+  Serial.println((team == TEAM_A) ? "A" : "B");
 }
 
 bool readIRSensor(int pin) {
@@ -204,9 +261,12 @@ void printScore() {
 // ===========================================
 
 void startNewGame() {
-  Serial.println("🏁 Starting new game! First to 10 points wins! 🏁");
+  Serial.print("🏁 Starting new game! First to ");
+  Serial.print(settings.pointsToWin);
+  Serial.println(" points wins! 🏁");
   resetScore();
   resetGoalDetection();
+  resetMatchStats(millis());
   currentGameState = GAME_ACTIVE;
   printGameStatus();
 }
@@ -216,10 +276,10 @@ void checkGameEnd() {
     return; // Game already ended
   }
   
-  if (scoreTeamA >= POINTS_TO_WIN) {
+  if (scoreTeamA >= settings.pointsToWin) {
     currentGameState = GAME_WON_TEAM_A;
     onGameWon(TEAM_A);
-  } else if (scoreTeamB >= POINTS_TO_WIN) {
+  } else if (scoreTeamB >= settings.pointsToWin) {
     currentGameState = GAME_WON_TEAM_B;
     onGameWon(TEAM_B);
   }
@@ -234,6 +294,11 @@ GameState getGameState() {
 }
 
 void onGameWon(Team winningTeam) {
+  endMatchStats(millis());
+  
+  // Trigger game win celebration before logging
+  celebrateGameWin(winningTeam);
+  
   Serial.println();
   Serial.println("🏆🏆🏆 GAME WON! 🏆🏆🏆");
   Serial.print("Team ");
@@ -242,20 +307,16 @@ void onGameWon(Team winningTeam) {
   printScore();
   Serial.println("🎉 Game celebration starting! 🎉");
   
-  // Trigger game win celebration
-  celebrateGameWin(winningTeam);
-  
   // Note: New game will start automatically after celebration ends
   Serial.println("New game will start automatically after celebration!");
 }
 
 void celebrateGameWin(Team winningTeam) {
-  // Trigger extended LED celebration for game win
-  Serial.print("🎆 Celebrating GAME WIN for Team ");
-  Serial.println((winningTeam == TEAM_A) ? "A" : "B");
-  
   // Trigger game win celebration (1 = Team A, 2 = Team B)
   triggerGameWinCelebration((winningTeam == TEAM_A) ? 1 : 2);
+  
+  Serial.print("🎆 Celebrating GAME WIN for Team ");
+  Serial.println((winningTeam == TEAM_A) ? "A" : "B");
 }
 
 void onGameWinCelebrationEnd() {
@@ -266,7 +327,7 @@ void onGameWinCelebrationEnd() {
 void printGameStatus() {
   Serial.println("📊 Game Status:");
   Serial.print("🎯 Target: ");
-  Serial.print(POINTS_TO_WIN);
+  Serial.print(settings.pointsToWin);
   Serial.println(" points to win");
   printScore();
   
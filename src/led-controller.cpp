@@ -1,37 +1,37 @@
 #include "led-controller.h"
 #include "ir-controller.h" // Include IR controller for game management
+#include "settings.h"
+#include "animation-vm.h"
+#include "led-tables.h"
+#include "diagnostics.h"
 
 #define WAVE_SPEED 50        
-#define WAVE_WIDTH 20     
 
 
 CRGB leds[NUM_LEDS];
-LEDEffect currentEffect = LED_OFF;
-LEDEffect previousEffect = LED_FULL_WHITE; // Store previous effect for returning after celebration
-CRGB waveColor = CRGB::Red;
-unsigned long lastUpdate = 0;
-unsigned long wavePosition = 0;
-uint8_t breathingBrightness = 0;
-bool breathingDirection = true;
-
-// Goal celebration variables
-bool celebrationActive = false;
-unsigned long celebrationStartTime = 0;
-LEDEffect celebrationEffect = LED_OFF;
-CRGB celebrationColor = CRGB::White;
+LEDState ledState = {0, 0, 0x9E3779B9, 0, CRGB::Red, LED_OFF, LED_FULL_WHITE, 0};
+CelebrationState celebration = {0, CRGB::White, LED_OFF, false, 0, {}};
+FaultOverlay faultOverlay = {};
+PowerState power = {};
 
 const int sectionStarts[] = {SECTION_1_START, SECTION_2_START, SECTION_3_START, SECTION_4_START};
 const int sectionEnds[] = {SECTION_1_END, SECTION_2_END, SECTION_3_END, SECTION_4_END};
 const int sectionLengths[] = {72, 42, 72, 42}; // LEDs per section
 
+FrameState frame = {{{0, -1}, {0, -1}, {0, -1}, {0, -1}}, {{0, -1}, {0, -1}, {0, -1}, {0, -1}}, 0, 0, false, false};
+
 void initLEDs() {
   Serial.println("Initializing LED strip...");
   
   FastLED.addLeds<LED_TYPE, LED_PIN, COLOR_ORDER>(leds, NUM_LEDS);
-  FastLED.setBrightness(BRIGHTNESS);
+  FastLED.setBrightness(settings.brightness);
+  power.requestedBrightness = settings.brightness;
+  power.governedBrightness = settings.brightness;
   FastLED.clear();
   FastLED.show();
   
+  setEffectRandomSeed(esp_random()); // Hardware RNG; reseed to replay a run
+  
   Serial.print("LED strip initialized with ");
   Serial.print(NUM_LEDS);
   Serial.println(" LEDs");
@@ -40,42 +40,46 @@ void initLEDs() {
 
 void updateLEDs() {
   unsigned long currentTime = millis();
+  ledState.frameTime = currentTime;
   
   // Determine celebration duration based on effect type
   unsigned long celebrationDuration;
   unsigned long celebrationSpeed;
   
-  if (currentEffect == LED_GOAL_CELEBRATION_A || currentEffect == LED_GOAL_CELEBRATION_B) {
-    celebrationDuration = GOAL_CELEBRATION_DURATION;
+  if (ledState.currentEffect == LED_GOAL_CELEBRATION_A || ledState.currentEffect == LED_GOAL_CELEBRATION_B) {
+    celebrationDuration = settings.goalCelebrationDuration;
     celebrationSpeed = CELEBRATION_WAVE_SPEED;
-  } else if (currentEffect == LED_GAME_WIN_CELEBRATION_A || currentEffect == LED_GAME_WIN_CELEBRATION_B) {
-    celebrationDuration = GAME_WIN_CELEBRATION_DURATION;
+  } else if (ledState.currentEffect == LED_GAME_WIN_CELEBRATION_A || ledState.currentEffect == LED_GAME_WIN_CELEBRATION_B) {
+    celebrationDuration = settings.gameWinCelebrationDuration;
     celebrationSpeed = GAME_WIN_WAVE_SPEED;
   } else {
-    celebrationDuration = GOAL_CELEBRATION_DURATION; // Default
+    celebrationDuration = settings.goalCelebrationDuration; // Default
     celebrationSpeed = CELEBRATION_WAVE_SPEED;
   }
   
   // Check if celebration should end
-  if (celebrationActive && currentTime - celebrationStartTime > celebrationDuration) {
-    endCelebration();
+  if (celebration.active) {
+    unsigned long elapsed = currentTime - celebration.startTime;
+    bool isGoalCelebration = (ledState.currentEffect == LED_GOAL_CELEBRATION_A || ledState.currentEffect == LED_GOAL_CELEBRATION_B);
+    
+    // Cut goal celebrations short when more are waiting so feedback latency stays bounded
+    if (elapsed > celebrationDuration ||
+        (isGoalCelebration && celebration.queueCount > 0 && elapsed > GOAL_CELEBRATION_MIN_DURATION)) {
+      endCelebration();
+    }
   }
   
   // Handle celebration effects with higher priority
-  if (celebrationActive) {
-    if (currentTime - lastUpdate >= celebrationSpeed) {
-      if (currentEffect == LED_GOAL_CELEBRATION_A || currentEffect == LED_GOAL_CELEBRATION_B) {
-        showGoalCelebration();
-      } else if (currentEffect == LED_GAME_WIN_CELEBRATION_A || currentEffect == LED_GAME_WIN_CELEBRATION_B) {
-        showGameWinCelebration();
-      }
-      lastUpdate = currentTime;
+  if (celebration.active) {
+    if (currentTime - ledState.lastUpdate >= celebrationSpeed) {
+      renderCelebrationFrame();
     }
+    showLEDs(); // Flush pending brightness changes
     return; // Skip normal effects during celebration
   }
   
   // Normal effect updates
-  switch (currentEffect) {
+  switch (ledState.currentEffect) {
     case LED_OFF:
       // No update needed
       break;
@@ -85,23 +89,31 @@ void updateLEDs() {
       break;
       
     case LED_COLOR_WAVE:
-      if (currentTime - lastUpdate >= WAVE_SPEED) {
+      if (currentTime - ledState.lastUpdate >= WAVE_SPEED) {
         showColorWave();
-        lastUpdate = currentTime;
+        ledState.lastUpdate = currentTime;
       }
       break;
       
     case LED_RAINBOW_WAVE:
-      if (currentTime - lastUpdate >= WAVE_SPEED) {
+      if (currentTime - ledState.lastUpdate >= WAVE_SPEED) {
         showRainbowWave();
-        lastUpdate = currentTime;
+        ledState.lastUpdate = currentTime;
       }
       break;
       
     case LED_BREATHING:
-      if (currentTime - lastUpdate >= 20) { 
+      if (currentTime - ledState.lastUpdate >= 20) { 
         showBreathing();
-        lastUpdate = currentTime;
+        ledState.lastUpdate = currentTime;
+      }
+      break;
+      
+    case LED_VM_PROGRAM:
+      if (currentTime - ledState.lastUpdate >= VM_FRAME_INTERVAL) {
+        runVMFrame();
+        showLEDs();
+        ledState.lastUpdate = currentTime;
       }
       break;
       
@@ -112,13 +124,15 @@ void updateLEDs() {
       // These are handled above in celebration logic
       break;
   }
+  
+  showLEDs(); // Flush pending brightness changes
 }
 
 void setLEDEffect(LEDEffect effect) {
-  if (currentEffect != effect && !celebrationActive) {
-    previousEffect = currentEffect; // Store previous effect
-    currentEffect = effect;
-    FastLED.clear();
+  if (ledState.currentEffect != effect && !celebration.active) {
+    ledState.previousEffect = ledState.currentEffect; // Store previous effect
+    ledState.currentEffect = effect;
+    clearAllSections();
     
     Serial.print("LED Effect changed to: ");
     switch (effect) {
@@ -132,16 +146,19 @@ void setLEDEffect(LEDEffect effect) {
         break;
       case LED_COLOR_WAVE:
         Serial.println("COLOR WAVE");
-        wavePosition = 0;
+        ledState.wavePosition = 0;
         break;
       case LED_RAINBOW_WAVE:
         Serial.println("RAINBOW WAVE");
-        wavePosition = 0;
+        ledState.wavePosition = 0;
         break;
       case LED_BREATHING:
         Serial.println("BREATHING");
-        breathingBrightness = 0;
-        breathingDirection = true;
+        ledState.breathingPhase = 0;
+        break;
+      case LED_VM_PROGRAM:
+        Serial.println("VM PROGRAM");
+        resetVM();
         break;
       case LED_GOAL_CELEBRATION_A:
         Serial.println("GOAL CELEBRATION TEAM A");
@@ -160,7 +177,7 @@ void setLEDEffect(LEDEffect effect) {
 }
 
 void setWaveColor(CRGB color) {
-  waveColor = color;
+  ledState.waveColor = color;
   Serial.print("Wave color set to RGB(");
   Serial.print(color.r);
   Serial.print(", ");
@@ -171,110 +188,142 @@ void setWaveColor(CRGB color) {
 }
 
 void setBrightness(uint8_t brightness) {
-  FastLED.setBrightness(brightness);
-  FastLED.show();
+  applyBrightness(brightness); // Pushed out with the next frame
   Serial.print("Brightness set to: ");
   Serial.println(brightness);
 }
 
 void showFullWhite() {
+  renderFullWhite();
+  showLEDs();
+}
+
+void renderFullWhite() {
   for (int section = 0; section < 4; section++) {
     fillSection(sectionStarts[section], sectionEnds[section], CRGB::White);
   }
-  FastLED.show();
 }
 
 void showColorWave() {
-  FastLED.clear();
-  
+  renderColorWave();
+  showLEDs();
+}
+
+void renderColorWave() {
   for (int section = 0; section < 4; section++) {
-    int sectionStart = sectionStarts[section];
-    int sectionEnd = sectionEnds[section];
-    int sectionLength = sectionLengths[section];
-    
-    int localWavePos = (wavePosition + section * 30) % (sectionLength + WAVE_WIDTH);
+    int localWavePos = (ledState.wavePosition + section * 30) % (sectionLengths[section] + WAVE_WIDTH);
+    renderWaveSection(section, localWavePos, WAVE_WIDTH, ledState.waveColor);
+  }
+  
+  ledState.wavePosition++;
+  if (ledState.wavePosition > 300) ledState.wavePosition = 0; 
+}
+
+// Single color wave over one section. Only the pixels under the wave can be
+// lit, everything else lit in the section is cleared.
+void renderWaveSection(int section, int waveCenter, int waveWidth, CRGB color) {
+  int windowStart, windowEnd;
+  bool visible = getWaveWindow(section, waveCenter, waveWidth, windowStart, windowEnd);
+  clearSectionOutside(section, windowStart, windowEnd);
+  if (!visible) return;
+  
+  int sectionStart = sectionStarts[section];
+  for (int i = windowStart; i <= windowEnd; i++) {
+    uint8_t intensity = getWaveIntensity(i - sectionStart, waveCenter, waveWidth);
     
-    for (int i = sectionStart; i <= sectionEnd; i++) {
-      int localIndex = i - sectionStart;
-      uint8_t intensity = getWaveIntensity(localIndex, localWavePos, WAVE_WIDTH);
-      
-      if (intensity > 0) {
-        leds[i] = waveColor;
-        leds[i].fadeToBlackBy(255 - intensity);
-      }
+    CRGB pixel = CRGB::Black;
+    if (intensity > 0) {
+      pixel = color;
+      pixel.fadeToBlackBy(255 - intensity);
     }
+    setSectionPixel(section, i, pixel);
   }
-  
-  wavePosition++;
-  if (wavePosition > 300) wavePosition = 0; 
-  
-  FastLED.show();
 }
 
 void showRainbowWave() {
-  FastLED.clear();
+  renderRainbowWave();
+  showLEDs();
+}
+
+void renderRainbowWave() {
+  // The hue shift is the same for every pixel, wrap it once per frame
+  uint8_t hueShift = (ledState.wavePosition * 2) % 255;
   
   for (int section = 0; section < 4; section++) {
     int sectionStart = sectionStarts[section];
-    int sectionEnd = sectionEnds[section];
     int sectionLength = sectionLengths[section];
     
-    int localWavePos = (wavePosition + section * 20) % (sectionLength + WAVE_WIDTH);
+    int localWavePos = (ledState.wavePosition + section * 20) % (sectionLength + WAVE_WIDTH);
     
-    for (int i = sectionStart; i <= sectionEnd; i++) {
+    // Only the pixels under the wave can be lit, everything else is cleared
+    int windowStart, windowEnd;
+    bool visible = getWaveWindow(section, localWavePos, WAVE_WIDTH, windowStart, windowEnd);
+    clearSectionOutside(section, windowStart, windowEnd);
+    if (!visible) continue;
+    
+    for (int i = windowStart; i <= windowEnd; i++) {
       int localIndex = i - sectionStart;
       uint8_t intensity = getWaveIntensity(localIndex, localWavePos, WAVE_WIDTH);
       
+      CRGB color = CRGB::Black;
       if (intensity > 0) {
-        uint8_t hue = (i * 255 / NUM_LEDS + wavePosition * 2) % 255;
-        leds[i] = CHSV(hue, 255, intensity);
+        uint16_t hue = hueOffsetTable.values[i] + hueShift;
+        if (hue >= 255) hue -= 255;
+        const RGBEntry &rgb = rainbowTable.values[hue];
+        color = CRGB(rgb.r, rgb.g, rgb.b);
+        color.nscale8_video(gammaTable.values[intensity]);
       }
+      setSectionPixel(section, i, color);
     }
   }
   
-  wavePosition++;
-  if (wavePosition > 300) wavePosition = 0;
-  
-  FastLED.show();
+  ledState.wavePosition++;
+  if (ledState.wavePosition > 300) ledState.wavePosition = 0;
 }
 
 void showBreathing() {
+  renderBreathing();
+  showLEDs();
+}
+
+void renderBreathing() {
+  // Pixels stay white (unchanged after the first frame), only brightness moves
   for (int section = 0; section < 4; section++) {
     fillSection(sectionStarts[section], sectionEnds[section], CRGB::White);
   }
   
-  if (breathingDirection) {
-    breathingBrightness += 2;
-    if (breathingBrightness >= 255) {
-      breathingBrightness = 255;
-      breathingDirection = false;
-    }
-  } else {
-    breathingBrightness -= 2;
-    if (breathingBrightness <= 20) {
-      breathingBrightness = 20;
-      breathingDirection = true;
-    }
+  applyBrightness(breathingTable.values[ledState.breathingPhase]);
+  ledState.breathingPhase++; // Wraps around to start the next breath
+}
+
+// Re-render static effects after something else drew over the strip
+void redrawCurrentEffect() {
+  if (ledState.currentEffect == LED_FULL_WHITE) {
+    showFullWhite();
   }
-  
-  FastLED.setBrightness(breathingBrightness);
-  FastLED.show();
 }
 
 void turnOffLEDs() {
-  FastLED.clear();
-  FastLED.show();
+  clearAllSections();
+  showLEDs();
 }
 
+// Spans never cross a section boundary, look the section up once
 void fillSection(int startLED, int endLED, CRGB color) {
+  int section = getSectionIndex(startLED);
   for (int i = startLED; i <= endLED; i++) {
-    leds[i] = color;
+    setSectionPixel(section, i, color);
   }
 }
 
 void fadeSection(int startLED, int endLED, uint8_t fadeAmount) {
+  int section = getSectionIndex(startLED);
   for (int i = startLED; i <= endLED; i++) {
-    leds[i].fadeToBlackBy(fadeAmount);
+    if (leds[i]) {
+      CRGB color = leds[i];
+      color.fadeToBlackBy(fadeAmount);
+      setSectionPixel(section, i, color);
+    }
   }
 }
 
@@ -299,6 +348,317 @@ int getSectionLength(int section) {
   return 0;
 }
 
+int getSectionIndex(int index) {
+  for (int section = 0; section < 4; section++) {
+    if (index >= sectionStarts[section] && index <= sectionEnds[section]) {
+      return section;
+    }
+  }
+  return -1;
+}
+
+bool getWaveWindow(int section, int waveCenter, int waveWidth, int &windowStart, int &windowEnd) {
+  windowStart = max(sectionStarts[section], sectionStarts[section] + waveCenter - waveWidth / 2);
+  windowEnd = min(sectionEnds[section], sectionStarts[section] + waveCenter + waveWidth / 2);
+  return windowStart <= windowEnd;
+}
+
+// ===========================================
+// DIRTY TRACKING
+// ===========================================
+
+void extendRange(DirtyRange &range, int startLED, int endLED) {
+  if (range.end < range.start) {
+    range.start = startLED;
+    range.end = endLED;
+    return;
+  }
+  if (startLED < range.start) range.start = startLED;
+  if (endLED > range.end) range.end = endLED;
+}
+
+void setPixel(int index, CRGB color) {
+  setSectionPixel(getSectionIndex(index), index, color);
+}
+
+// Same as setPixel for callers that already know the section (-1 = none),
+// saves the section lookup on every pixel of a span
+void setSectionPixel(int section, int index, CRGB color) {
+  CRGB old = leds[index];
+  if (old == color) {
+    return; // Unchanged pixels don't dirty the frame
+  }
+  leds[index] = color;
+  
+  // Keep the power estimate current while the frame is drawn
+  power.channelSums[0] += (int)color.r - old.r;
+  power.channelSums[1] += (int)color.g - old.g;
+  power.channelSums[2] += (int)color.b - old.b;
+  
+  if (section < 0) {
+    frame.unsectionedDirty = true;
+    return;
+  }
+  extendRange(frame.dirty[section], index, index);
+  if (color) {
+    extendRange(frame.lit[section], index, index);
+  }
+}
+
+void clearSection(int section) {
+  clearSectionOutside(section, 0, -1);
+}
+
+void clearSectionOutside(int section, int keepStart, int keepEnd) {
+  DirtyRange lit = frame.lit[section];
+  for (int i = lit.start; i <= lit.end; i++) {
+    if (i < keepStart || i > keepEnd) {
+      setSectionPixel(section, i, CRGB::Black);
+    }
+  }
+  
+  // Whatever stays lit is inside the kept window
+  frame.lit[section].start = max((int)lit.start, keepStart);
+  frame.lit[section].end = min((int)lit.end, keepEnd);
+}
+
+void clearAllSections() {
+  for (int section = 0; section < 4; section++) {
+    clearSection(section);
+  }
+}
+
+// Effects and settings request a brightness, the governor decides what is sent
+void applyBrightness(uint8_t brightness) {
+  if (power.requestedBrightness != brightness) {
+    power.requestedBrightness = brightness;
+    frame.brightnessChanged = true;
+  }
+}
+
+// Estimated strip current of the current frame at brightness 255, without idle draw
+uint32_t getFullScaleMilliamps() {
+  return (power.channelSums[0] * POWER_MA_RED +
+          power.channelSums[1] * POWER_MA_GREEN +
+          power.channelSums[2] * POWER_MA_BLUE) / 255;
+}
+
+// Scales brightness down to the power budget. Drops immediately to protect
+// the supply and recovers in small steps so a limited frame doesn't flicker.
+void governBrightness() {
+  uint32_t fullScale = getFullScaleMilliamps();
+  uint32_t idle = (uint32_t)POWER_MA_IDLE * NUM_LEDS;
+  uint8_t target = power.requestedBrightness;
+  
+  if (settings.powerBudget > 0 && fullScale > 0) {
+    uint32_t available = (settings.powerBudget > idle) ? settings.powerBudget - idle : 0;
+    uint32_t limit = available * 255 / fullScale;
+    if (limit < target) {
+      target = limit;
+    }
+  }
+  
+  uint8_t brightness = power.governedBrightness;
+  if (target < brightness || !power.limiting) {
+    brightness = target;
+  } else if (target > brightness && millis() - power.lastRampTime >= POWER_RAMP_INTERVAL) {
+    power.lastRampTime = millis();
+    brightness = (target - brightness > POWER_RAMP_STEP) ? brightness + POWER_RAMP_STEP : target;
+  }
+  
+  power.governedBrightness = brightness;
+  power.limiting = (brightness < power.requestedBrightness);
+  if (FastLED.getBrightness() != brightness) {
+    FastLED.setBrightness(brightness);
+    frame.brightnessChanged = true;
+  }
+}
+
+bool isFrameDirty() {
+  if (frame.brightnessChanged || frame.unsectionedDirty) {
+    return true;
+  }
+  for (int section = 0; section < 4; section++) {
+    if (frame.dirty[section].end >= frame.dirty[section].start) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void showLEDs() {
+  drawFaultOverlay();
+  governBrightness();
+  
+  if (!isFrameDirty()) {
+    frame.framesSkipped++;
+    return;
+  }
+  
+  markGoalLatency(LATENCY_RENDERED);
+  FastLED.show();
+  frame.framesShown++;
+  markGoalLatency(LATENCY_SHOWN);
+  
+  // Power instrumentation for the frame just sent
+  uint32_t milliamps = (uint32_t)POWER_MA_IDLE * NUM_LEDS + getFullScaleMilliamps() * power.governedBrightness / 255;
+  power.estimatedMilliamps = min(milliamps, (uint32_t)0xFFFF);
+  if (power.estimatedMilliamps > power.peakMilliamps) {
+    power.peakMilliamps = power.estimatedMilliamps;
+  }
+  if (power.limiting) {
+    power.limitedFrames++;
+  }
+  
+#ifdef LED_FRAME_TRACE
+  printFrameChecksum();
+#endif
+  
+  for (int section = 0; section < 4; section++) {
+    frame.dirty[section].start = 0;
+    frame.dirty[section].end = -1;
+  }
+  frame.unsectionedDirty = false;
+  frame.brightnessChanged = false;
+}
+
+// ===========================================
+// SENSOR FAULT DIAGNOSTICS
+// ===========================================
+
+void setSectionFault(int section, bool fault, CRGB color) {
+  if (section < 0 || section >= 4) return;
+  
+  if (fault) {
+    faultOverlay.sections |= (1 << section);
+    faultOverlay.colors[section] = color;
+    return;
+  }
+  
+  faultOverlay.sections &= ~(1 << section);
+  clearSection(section);
+  redrawCurrentEffect();
+}
+
+// Blinks faulty sections in their fault color; unchanged pixels stay clean
+void drawFaultOverlay() {
+  if (faultOverlay.sections == 0) return;
+  
+  bool on = (millis() / FAULT_BLINK_INTERVAL) & 1;
+  for (int section = 0; section < 4; section++) {
+    if (faultOverlay.sections & (1 << section)) {
+      fillSection(sectionStarts[section], sectionEnds[section], on ? faultOverlay.colors[section] : CRGB(CRGB::Black));
+    }
+  }
+}
+
+DirtyRange getSectionDirtyRange(int section) {
+  if (section >= 0 && section < 4) {
+    return frame.dirty[section];
+  }
+  DirtyRange empty = {0, -1};
+  return empty;
+}
+
+unsigned long getFramesShown() {
+  return frame.framesShown;
+}
+
+unsigned long getFramesSkipped() {
+  return frame.framesSkipped;
+}
+
+void printFrameStats() {
+  Serial.print("Frames shown: ");
+  Serial.print(frame.framesShown);
+  Serial.print(" | skipped: ");
+  Serial.println(frame.framesSkipped);
+  Serial.print("⚡ Strip current: ");
+  Serial.print(power.estimatedMilliamps);
+  Serial.print(" mA | peak: ");
+  Serial.print(power.peakMilliamps);
+  Serial.print(" mA | budget: ");
+  Serial.print(settings.powerBudget);
+  Serial.print(" mA | limited frames: ");
+  Serial.println(power.limitedFrames);
+}
+
+// ===========================================
+// FRAME VERIFICATION
+// ===========================================
+
+// CRC-32 over the used sections plus the requested brightness. The governor's
+// cut is left out so the CRC only depends on what the effect drew.
+uint32_t getFrameChecksum() {
+  uint32_t crc = 0xFFFFFFFF;
+  const uint8_t* bytes = (const uint8_t*)leds;
+  int length = (SECTION_4_END + 1) * 3;
+  
+  for (int i = 0; i <= length; i++) {
+    crc ^= (i < length) ? bytes[i] : power.requestedBrightness;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ (0xEDB88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+void printFrameChecksum() {
+  Serial.print("FRAME ");
+  Serial.print(frame.framesShown);
+  Serial.print(" CRC ");
+  Serial.println(getFrameChecksum(), HEX);
+}
+
+// Dump the used sections as a one-row ASCII PPM (P3) image
+void dumpFrame() {
+  Serial.println("P3");
+  Serial.print(SECTION_4_END + 1);
+  Serial.println(" 1");
+  Serial.println("255");
+  for (int i = 0; i <= SECTION_4_END; i++) {
+    Serial.print(leds[i].r);
+    Serial.print(' ');
+    Serial.print(leds[i].g);
+    Serial.print(' ');
+    Serial.println(leds[i].b);
+  }
+}
+
+// ===========================================
+// EFFECT RANDOMNESS
+// ===========================================
+
+// Seed the sparkle randomness so a run can be reproduced frame by frame
+void setEffectRandomSeed(uint32_t seed) {
+  ledState.randomState = (seed != 0) ? seed : 0x9E3779B9; // xorshift must not start at 0
+}
+
+// xorshift32 - a few shifts per number, no locking, reproducible from the seed
+uint32_t effectRandom() {
+  uint32_t x = ledState.randomState;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  ledState.randomState = x;
+  return x;
+}
+
+// Uniform value in [0, range) without modulo bias (Lemire's multiply-shift)
+uint16_t effectRandomRange(uint16_t range) {
+  uint64_t product = (uint64_t)effectRandom() * range;
+  uint32_t low = (uint32_t)product;
+  
+  if (low < range) {
+    uint32_t threshold = (0u - range) % range;
+    while (low < threshold) {
+      product = (uint64_t)effectRandom() * range;
+      low = (uint32_t)product;
+    }
+  }
+  return product >> 32;
+}
+
 uint8_t getWaveIntensity(int position, int waveCenter, int waveWidth) {
   int distance = abs(position - waveCenter);
   
@@ -321,58 +681,58 @@ CRGB blendColors(CRGB color1, CRGB color2, uint8_t blend) {
 
 // Goal celebration functions
 void triggerGoalCelebration(int team) {
-  if (celebrationActive) return; // Don't interrupt ongoing celebration
-  
-  Serial.print("🎉 Starting goal celebration for Team ");
-  Serial.println((team == 1) ? "A (RED)" : "B (BLUE)");
-  
-  celebrationActive = true;
-  celebrationStartTime = millis();
-  previousEffect = currentEffect; // Store current effect to restore later
-  
   if (team == 1) {
-    celebrationEffect = LED_GOAL_CELEBRATION_A;
-    celebrationColor = TEAM_A_COLOR;
-    currentEffect = LED_GOAL_CELEBRATION_A;
+    queueCelebration(LED_GOAL_CELEBRATION_A, TEAM_A_COLOR, CELEBRATION_PRIORITY_GOAL);
   } else {
-    celebrationEffect = LED_GOAL_CELEBRATION_B;
-    celebrationColor = TEAM_B_COLOR;
-    currentEffect = LED_GOAL_CELEBRATION_B;
+    queueCelebration(LED_GOAL_CELEBRATION_B, TEAM_B_COLOR, CELEBRATION_PRIORITY_GOAL);
   }
-  
-  wavePosition = 0; // Reset wave position for celebration
-  FastLED.setBrightness(255); // Full brightness for celebration
+}
+
+void renderCelebrationFrame() {
+  if (ledState.currentEffect == LED_GOAL_CELEBRATION_A || ledState.currentEffect == LED_GOAL_CELEBRATION_B) {
+    showGoalCelebration();
+  } else if (ledState.currentEffect == LED_GAME_WIN_CELEBRATION_A || ledState.currentEffect == LED_GAME_WIN_CELEBRATION_B) {
+    showGameWinCelebration();
+  }
+  ledState.lastUpdate = ledState.frameTime;
 }
 
 void showGoalCelebration() {
+  renderGoalCelebration();
+  showLEDs();
+}
+
+void renderGoalCelebration() {
   // Create intense team-colored wave effect
-  FastLED.clear();
+  clearAllSections();
   
   // Multiple waves for more dramatic effect
   for (int waveOffset = 0; waveOffset < 3; waveOffset++) {
-    int currentWavePos = (wavePosition + waveOffset * 50) % 300;
+    int currentWavePos = (ledState.wavePosition + waveOffset * 50) % 300;
     
     for (int section = 0; section < 4; section++) {
       int sectionStart = sectionStarts[section];
-      int sectionEnd = sectionEnds[section];
       int sectionLength = sectionLengths[section];
       
       // Map wave position to section
       int localWavePos = (currentWavePos + section * 30) % (sectionLength + WAVE_WIDTH);
       
-      for (int i = sectionStart; i <= sectionEnd; i++) {
+      int windowStart, windowEnd;
+      if (!getWaveWindow(section, localWavePos, WAVE_WIDTH, windowStart, windowEnd)) continue;
+      
+      for (int i = windowStart; i <= windowEnd; i++) {
         int localIndex = i - sectionStart;
         uint8_t intensity = getWaveIntensity(localIndex, localWavePos, WAVE_WIDTH);
         
         if (intensity > 0) {
           // Blend with existing color for multiple wave effect
-          CRGB newColor = celebrationColor;
+          CRGB newColor = celebration.color;
           newColor.fadeToBlackBy(255 - intensity);
           
           if (leds[i]) {
-            leds[i] = blendColors(leds[i], newColor, 128);
+            setSectionPixel(section, i, blendColors(leds[i], newColor, 128));
           } else {
-            leds[i] = newColor;
+            setSectionPixel(section, i, newColor);
           }
         }
       }
@@ -380,74 +740,63 @@ void showGoalCelebration() {
   }
   
   // Add sparkle effect for extra celebration
-  if (random(100) < 30) { // 30% chance per update
-    int sparklePos = random(NUM_LEDS);
-    if (sparklePos <= SECTION_4_END) { // Only in used sections
-      leds[sparklePos] = CRGB::White;
+  for (int sparkles = 0; sparkles < GOAL_SPARKLES; sparkles++) {
+    if (effectRandomRange(100) < GOAL_SPARKLE_CHANCE) {
+      setPixel(effectRandomRange(SECTION_4_END + 1), CRGB::White); // Only in used sections
     }
   }
   
-  wavePosition += 3; // Faster wave for celebration
-  FastLED.show();
+  ledState.wavePosition += 3; // Faster wave for celebration
 }
 
 void triggerGameWinCelebration(int team) {
-  if (celebrationActive) return; // Don't interrupt ongoing celebration
-  
-  Serial.print("🏆 Starting GAME WIN celebration for Team ");
-  Serial.println((team == 1) ? "A (YELLOW)" : "B (ORANGE)");
-  
-  celebrationActive = true;
-  celebrationStartTime = millis();
-  previousEffect = currentEffect; // Store current effect to restore later
-  
   if (team == 1) {
-    celebrationEffect = LED_GAME_WIN_CELEBRATION_A;
-    celebrationColor = TEAM_A_COLOR;
-    currentEffect = LED_GAME_WIN_CELEBRATION_A;
+    queueCelebration(LED_GAME_WIN_CELEBRATION_A, TEAM_A_COLOR, CELEBRATION_PRIORITY_GAME_WIN);
   } else {
-    celebrationEffect = LED_GAME_WIN_CELEBRATION_B;
-    celebrationColor = TEAM_B_COLOR;
-    currentEffect = LED_GAME_WIN_CELEBRATION_B;
+    queueCelebration(LED_GAME_WIN_CELEBRATION_B, TEAM_B_COLOR, CELEBRATION_PRIORITY_GAME_WIN);
   }
-  
-  wavePosition = 0; // Reset wave position for celebration
-  FastLED.setBrightness(255); // Full brightness for celebration
 }
 
 void showGameWinCelebration() {
+  renderGameWinCelebration();
+  showLEDs();
+}
+
+void renderGameWinCelebration() {
   // Create super intense team-colored celebration effect
-  FastLED.clear();
+  clearAllSections();
   
   // Multiple faster waves for game win effect
   for (int waveOffset = 0; waveOffset < 5; waveOffset++) {
-    int currentWavePos = (wavePosition + waveOffset * 40) % 300;
+    int currentWavePos = (ledState.wavePosition + waveOffset * 40) % 300;
     
     for (int section = 0; section < 4; section++) {
       int sectionStart = sectionStarts[section];
-      int sectionEnd = sectionEnds[section];
       int sectionLength = sectionLengths[section];
       
       // Map wave position to section
       int localWavePos = (currentWavePos + section * 25) % (sectionLength + WAVE_WIDTH);
       
-      for (int i = sectionStart; i <= sectionEnd; i++) {
+      int windowStart, windowEnd;
+      if (!getWaveWindow(section, localWavePos, WAVE_WIDTH, windowStart, windowEnd)) continue;
+      
+      for (int i = windowStart; i <= windowEnd; i++) {
         int localIndex = i - sectionStart;
         uint8_t intensity = getWaveIntensity(localIndex, localWavePos, WAVE_WIDTH);
         
         if (intensity > 0) {
           // Blend with existing color for multiple wave effect
-          CRGB newColor = celebrationColor;
+          CRGB newColor = celebration.color;
           newColor.fadeToBlackBy(255 - intensity);
           
           // Add pulsing effect for game win
-          uint8_t pulse = sin8(millis() / 50 + i * 10);
+          uint8_t pulse = sin8(ledState.frameTime / 50 + i * 10);
           newColor.fadeToBlackBy(255 - pulse);
           
           if (leds[i]) {
-            leds[i] = blendColors(leds[i], newColor, 100);
+            setSectionPixel(section, i, blendColors(leds[i], newColor, 100));
           } else {
-            leds[i] = newColor;
+            setSectionPixel(section, i, newColor);
           }
         }
       }
@@ -455,39 +804,158 @@ void showGameWinCelebration() {
   }
   
   // More intense sparkle effect for game win
-  for (int sparkles = 0; sparkles < 5; sparkles++) {
-    if (random(100) < 60) { // 60% chance per sparkle
-      int sparklePos = random(NUM_LEDS);
-      if (sparklePos <= SECTION_4_END) { // Only in used sections
-        leds[sparklePos] = CRGB::White;
-      }
+  for (int sparkles = 0; sparkles < GAME_WIN_SPARKLES; sparkles++) {
+    if (effectRandomRange(100) < GAME_WIN_SPARKLE_CHANCE) {
+      setPixel(effectRandomRange(SECTION_4_END + 1), CRGB::White); // Only in used sections
     }
   }
   
-  wavePosition += 5; // Much faster wave for game win
-  FastLED.show();
+  ledState.wavePosition += 5; // Much faster wave for game win
 }
 
 bool isCelebrationActive() {
-  return celebrationActive;
+  return celebration.active;
 }
 
 void endCelebration() {
-  if (!celebrationActive) return;
+  if (!celebration.active) return;
   
   // Check if this was a game win celebration
-  bool wasGameWinCelebration = (currentEffect == LED_GAME_WIN_CELEBRATION_A || 
-                               currentEffect == LED_GAME_WIN_CELEBRATION_B);
+  bool wasGameWinCelebration = (ledState.currentEffect == LED_GAME_WIN_CELEBRATION_A || 
+                               ledState.currentEffect == LED_GAME_WIN_CELEBRATION_B);
   
   Serial.println("🏁 Celebration ended");
-  celebrationActive = false;
   
-  // Restore previous effect and brightness
-  FastLED.setBrightness(BRIGHTNESS);
-  setLEDEffect(previousEffect);
+  // Hand over directly to the next queued celebration while still active, so
+  // the effect from before the first celebration is kept; otherwise restore
+  // previous effect and brightness
+  if (!startNextCelebration()) {
+    celebration.active = false;
+    
+    // Restoring a celebration effect with no celebration running would leave the strip dark
+    LEDEffect restore = ledState.previousEffect;
+    if (restore >= LED_GOAL_CELEBRATION_A) {
+      Serial.println("⚠️ No effect to restore after celebration - using full white");
+      restore = LED_FULL_WHITE;
+    }
+    applyBrightness(settings.brightness);
+    setLEDEffect(restore);
+  }
   
   // If it was a game win celebration, start a new game
   if (wasGameWinCelebration) {
     onGameWinCelebrationEnd();
   }
 }
+
+// ===========================================
+// CELEBRATION QUEUE
+// ===========================================
+
+bool queueCelebration(LEDEffect effect, CRGB color, uint8_t priority) {
+  CelebrationRequest request = {effect, color, priority};
+  
+  // A game win supersedes any goal celebrations still waiting
+  if (priority >= CELEBRATION_PRIORITY_GAME_WIN) {
+    int kept = 0;
+    for (int i = 0; i < celebration.queueCount; i++) {
+      if (celebration.queue[i].priority >= priority) {
+        celebration.queue[kept++] = celebration.queue[i];
+      }
+    }
+    celebration.queueCount = kept;
+  }
+  
+  // Nothing running: start right away
+  if (!celebration.active) {
+    startCelebration(request);
+    return true;
+  }
+  
+  // Higher priority preempts the running celebration
+  uint8_t runningPriority = (ledState.currentEffect == LED_GAME_WIN_CELEBRATION_A || ledState.currentEffect == LED_GAME_WIN_CELEBRATION_B)
+                            ? CELEBRATION_PRIORITY_GAME_WIN : CELEBRATION_PRIORITY_GOAL;
+  if (priority > runningPriority) {
+    Serial.println("⏭️ Celebration preempted");
+    startCelebration(request);
+    return true;
+  }
+  
+  // Coalesce with an identical request that is already waiting
+  for (int i = 0; i < celebration.queueCount; i++) {
+    if (celebration.queue[i].effect == effect) {
+      return true;
+    }
+  }
+  
+  // Queue full: evict the newest lower-priority request, or drop this one
+  if (celebration.queueCount >= CELEBRATION_QUEUE_SIZE) {
+    if (celebration.queue[celebration.queueCount - 1].priority >= priority) {
+      Serial.println("⚠️ Celebration queue full - request dropped");
+      return false;
+    }
+    celebration.queueCount--;
+  }
+  
+  // Insert after all requests of equal or higher priority
+  int pos = celebration.queueCount;
+  while (pos > 0 && celebration.queue[pos - 1].priority < priority) {
+    celebration.queue[pos] = celebration.queue[pos - 1];
+    pos--;
+  }
+  celebration.queue[pos] = request;
+  celebration.queueCount++;
+  return true;
+}
+
+void startCelebration(CelebrationRequest request) {
+  if (!celebration.active) {
+    ledState.previousEffect = ledState.currentEffect; // Store current effect to restore later
+  }
+  
+  celebration.active = true;
+  celebration.startTime = millis();
+  celebration.effect = request.effect;
+  celebration.color = request.color;
+  ledState.currentEffect = request.effect;
+  markGoalLatency(LATENCY_CELEBRATION);
+  
+  ledState.wavePosition = 0; // Reset wave position for celebration
+  applyBrightness(255); // Full brightness for celebration
+  
+  // Put the first frame on the strip now instead of waiting for the next
+  // update tick, and only then log
+  ledState.frameTime = celebration.startTime;
+  renderCelebrationFrame();
+  
+  if (request.priority >= CELEBRATION_PRIORITY_GAME_WIN) {
+    Serial.print("🏆 Starting GAME WIN celebration for Team ");
+    Serial.println((request.effect == LED_GAME_WIN_CELEBRATION_A) ? "A (YELLOW)" : "B (ORANGE)");
+  } else {
+    Serial.print("🎉 Starting goal celebration for Team ");
+    Serial.println((request.effect == LED_GOAL_CELEBRATION_A) ? "A (YELLOW)" : "B (ORANGE)");
+  }
+}
+
+bool startNextCelebration() {
+  if (celebration.queueCount == 0) {
+    return false;
+  }
+  
+  CelebrationRequest next = celebration.queue[0];
+  for (int i = 1; i < celebration.queueCount; i++) {
+    celebration.queue[i - 1] = celebration.queue[i];
+  }
+  celebration.queueCount--;
+  
+  startCelebration(next);
+  return true;
+}
+
+int getQueuedCelebrationCount() {
+  return celebration.queueCount;
+}
+
+void clearCelebrationQueue() {
+  celebration.queueCount = 0;
+}
@@ -0,0 +1,12 @@
+#include "led-tables.h"
+
+constexpr HueOffsetTable hueOffsetTable = makeHueOffsetTable();
+constexpr RainbowTable rainbowTable = makeRainbowTable();
+constexpr CurveTable gammaTable = makeGammaTable();
+constexpr CurveTable breathingTable = makeBreathingTable();
+
+// Spot checks that the tables really are built by the compiler
+static_assert(hueOffsetTable.values[NUM_LEDS - 1] == (NUM_LEDS - 1) * 255 / NUM_LEDS, "hue offsets");
+static_assert(rainbowTable.values[0].r == 255 && rainbowTable.values[0].g == 0, "rainbow starts at red");
+static_assert(gammaTable.values[0] == 0 && gammaTable.values[255] == 255, "gamma end points");
+static_assert(breathingTable.values[0] == BREATHING_MIN_BRIGHTNESS, "breathing starts dimmed");
@@ -1,17 +1,26 @@
 #include <Arduino.h>
 #include "led-controller.h"
 #include "ir-controller.h"
+#include "settings.h"
+#include "serial-console.h"
+#include "diagnostics.h"
 
 void setup() {
-  Serial.begin(9600);
+  Serial.setTxBufferSize(CONSOLE_TX_BUFFER_SIZE); // Must be set before begin()
+  Serial.begin(CONSOLE_BAUD_RATE);
   delay(1000);
 
+  loadSettings();
   initLEDs();
   initIRSensors();
   setLEDEffect(LED_OFF);
+  initConsole();
+  printMemoryReport();
 }
 
 void loop() {
+  unsigned long loopStart = micros();
+  
   updateLEDs();
   
   // Check for goals (IR sensors) - only during active games
@@ -44,6 +53,16 @@ void loop() {
     }
   }
   
-  // Your main application code goes here
+  // Runtime tuning over serial - consumes a few bytes per loop
+  updateConsole();
+  
   // No delay needed - the loop runs freely
+  recordLoopTime(micros() - loopStart);
+  
+  // Track stack and heap low-water marks once per second
+  static unsigned long lastMemoryCheck = 0;
+  if (millis() - lastMemoryCheck >= 1000) {
+    lastMemoryCheck = millis();
+    updateMemoryStats();
+  }
 }
@@ -0,0 +1,141 @@
+#include "match-stats.h"
+
+// Upper bounds of the goal interval buckets in seconds, the last bucket is open-ended
+const uint16_t intervalBucketLimits[GOAL_INTERVAL_BUCKETS - 1] = {5, 10, 20, 30, 60, 120, 300};
+
+MatchStats matchStats;
+
+void resetMatchStats(unsigned long startTime) {
+  memset(&matchStats, 0, sizeof(matchStats));
+  matchStats.startTime = startTime;
+  matchStats.streakTeam = TEAM_A;
+}
+
+void recordGoalEvent(GoalEvent event) {
+  if (!event.isValid || matchStats.endTime != 0) {
+    return;
+  }
+  
+  // Time between goals
+  if (matchStats.lastGoalTime != 0) {
+    unsigned long interval = event.timestamp - matchStats.lastGoalTime;
+    matchStats.totalInterval += interval;
+    if (matchStats.intervalCount == 0 || interval < matchStats.shortestInterval) {
+      matchStats.shortestInterval = interval;
+    }
+    if (interval > matchStats.longestInterval) {
+      matchStats.longestInterval = interval;
+    }
+    matchStats.intervalCount++;
+    matchStats.intervalHistogram[getIntervalBucket(interval)]++;
+  }
+  matchStats.lastGoalTime = event.timestamp;
+  
+  // Score
+  if (event.team == TEAM_A) {
+    matchStats.goalsTeamA++;
+  } else {
+    matchStats.goalsTeamB++;
+  }
+  
+  // Streaks
+  if (matchStats.streakLength > 0 && matchStats.streakTeam == event.team) {
+    matchStats.streakLength++;
+  } else {
+    matchStats.streakTeam = event.team;
+    matchStats.streakLength = 1;
+  }
+  if (event.team == TEAM_A && matchStats.streakLength > matchStats.longestStreakTeamA) {
+    matchStats.longestStreakTeamA = matchStats.streakLength;
+  } else if (event.team == TEAM_B && matchStats.streakLength > matchStats.longestStreakTeamB) {
+    matchStats.longestStreakTeamB = matchStats.streakLength;
+  }
+  
+  // Deficits, for the comeback margin
+  if (matchStats.goalsTeamB > matchStats.goalsTeamA) {
+    uint8_t deficit = matchStats.goalsTeamB - matchStats.goalsTeamA;
+    if (deficit > matchStats.maxDeficitTeamA) matchStats.maxDeficitTeamA = deficit;
+  } else if (matchStats.goalsTeamA > matchStats.goalsTeamB) {
+    uint8_t deficit = matchStats.goalsTeamA - matchStats.goalsTeamB;
+    if (deficit > matchStats.maxDeficitTeamB) matchStats.maxDeficitTeamB = deficit;
+  }
+}
+
+void endMatchStats(unsigned long endTime) {
+  if (matchStats.endTime == 0) {
+    matchStats.endTime = endTime;
+  }
+}
+
+const MatchStats& getMatchStats() {
+  return matchStats;
+}
+
+unsigned long getMatchDuration(unsigned long now) {
+  unsigned long end = (matchStats.endTime != 0) ? matchStats.endTime : now;
+  return end - matchStats.startTime;
+}
+
+float getGoalsPerMinute(unsigned long now) {
+  unsigned long duration = getMatchDuration(now);
+  if (duration == 0) return 0;
+  return (matchStats.goalsTeamA + matchStats.goalsTeamB) * 60000.0f / duration;
+}
+
+unsigned long getAverageGoalInterval() {
+  if (matchStats.intervalCount == 0) return 0;
+  return matchStats.totalInterval / matchStats.intervalCount;
+}
+
+// Largest deficit the current leader came back from (0 when tied)
+uint8_t getComebackMargin() {
+  if (matchStats.goalsTeamA > matchStats.goalsTeamB) {
+    return matchStats.maxDeficitTeamA;
+  } else if (matchStats.goalsTeamB > matchStats.goalsTeamA) {
+    return matchStats.maxDeficitTeamB;
+  }
+  return 0;
+}
+
+int getIntervalBucket(unsigned long interval) {
+  unsigned long seconds = interval / 1000;
+  for (int bucket = 0; bucket < GOAL_INTERVAL_BUCKETS - 1; bucket++) {
+    if (seconds < intervalBucketLimits[bucket]) {
+      return bucket;
+    }
+  }
+  return GOAL_INTERVAL_BUCKETS - 1;
+}
+
+void printMatchStats() {
+  unsigned long now = millis();
+  
+  Serial.println("📈 Match Stats:");
+  Serial.print("Duration: ");
+  Serial.print(getMatchDuration(now) / 1000);
+  Serial.println(" s");
+  Serial.print("Goals per minute: ");
+  Serial.println(getGoalsPerMinute(now), 2);
+  Serial.print("Time between goals (avg/min/max): ");
+  Serial.print(getAverageGoalInterval() / 1000);
+  Serial.print(" / ");
+  Serial.print(matchStats.shortestInterval / 1000);
+  Serial.print(" / ");
+  Serial.print(matchStats.longestInterval / 1000);
+  Serial.println(" s");
+  Serial.print("Longest streak - Team A: ");
+  Serial.print(matchStats.longestStreakTeamA);
+  Serial.print(" | Team B: ");
+  Serial.println(matchStats.longestStreakTeamB);
+  Serial.print("Comeback margin: ");
+  Serial.println(getComebackMargin());
+  
+  Serial.print("Goal intervals:");
+  for (int bucket = 0; bucket < GOAL_INTERVAL_BUCKETS; bucket++) {
+    Serial.print(bucket < GOAL_INTERVAL_BUCKETS - 1 ? " <" : " >=");
+    Serial.print(intervalBucketLimits[bucket < GOAL_INTERVAL_BUCKETS - 1 ? bucket : bucket - 1]);
+    Serial.print("s:");
+    Serial.print(matchStats.intervalHistogram[bucket]);
+  }
+  Serial.println();
+}
@@ -0,0 +1,64 @@
+#include "sensor-health.h"
+
+void resetSensorHealth(SensorHealthState &state, unsigned long now) {
+  state.blockedSince = now;
+  state.lastBreak = now;
+  state.lastGood = now;
+  state.flickerWindowStart = now;
+  state.flickerCount = 0;
+  state.flickerRate = 0;
+  state.lastReading = false;
+  state.health = SENSOR_OK;
+}
+
+// Feed one sample; returns true when the health state changed. Constant time.
+bool updateSensorHealth(SensorHealthState &state, bool blocked, unsigned long otherLastBreak, unsigned long now) {
+  if (blocked != state.lastReading) {
+    if (state.flickerCount < 0xFFFF) state.flickerCount++;
+    if (blocked) {
+      state.blockedSince = now;
+      state.lastBreak = now;
+    }
+    state.lastReading = blocked;
+  }
+  
+  if (now - state.flickerWindowStart >= SENSOR_FLICKER_WINDOW) {
+    state.flickerRate = state.flickerCount;
+    state.flickerCount = 0;
+    state.flickerWindowStart = now;
+  }
+  
+  SensorHealth health = SENSOR_OK;
+  if (blocked && now - state.blockedSince > SENSOR_STUCK_BLOCKED_TIME) {
+    health = SENSOR_STUCK_BLOCKED;
+  } else if (state.flickerRate > SENSOR_FLICKER_LIMIT) {
+    health = SENSOR_FLICKERING;
+  } else if (!blocked && now - state.lastBreak > SENSOR_STUCK_CLEAR_TIME &&
+             (long)(otherLastBreak - state.lastBreak) > 0) {
+    health = SENSOR_STUCK_CLEAR;
+  }
+  
+  if (health == SENSOR_OK) {
+    state.lastGood = now;
+  }
+  
+  bool changed = (health != state.health);
+  state.health = health;
+  return changed;
+}
+
+// A beam that never breaks can't score phantom goals, so only a stuck
+// or flickering beam is taken out of goal detection
+bool canSensorScore(const SensorHealthState &state) {
+  return state.health == SENSOR_OK || state.health == SENSOR_STUCK_CLEAR;
+}
+
+const char* getSensorHealthName(SensorHealth health) {
+  switch (health) {
+    case SENSOR_OK:            return "OK";
+    case SENSOR_STUCK_BLOCKED: return "STUCK BLOCKED";
+    case SENSOR_STUCK_CLEAR:   return "STUCK CLEAR";
+    case SENSOR_FLICKERING:    return "FLICKERING";
+  }
+  return "UNKNOWN";
+}
@@ -0,0 +1,249 @@
+#include "serial-console.h"
+#include "ir-controller.h"
+#include "led-controller.h"
+#include "settings.h"
+#include "diagnostics.h"
+#include "match-stats.h"
+#include "animation-vm.h"
+#include "golden-frames.h"
+
+ConsoleState console = {{0}, 0, false};
+
+void initConsole() {
+  console.length = 0;
+  console.overflow = false;
+  Serial.println("Serial console ready - type 'help' for commands");
+}
+
+void updateConsole() {
+  unsigned long startTime = micros();
+  
+  // Consume only a few bytes per call so the main loop keeps its pace
+  for (int n = 0; n < CONSOLE_BYTES_PER_UPDATE && Serial.available() > 0; n++) {
+    char c = (char)Serial.read();
+    
+    if (c == '\n' || c == '\r') {
+      if (console.overflow) {
+        Serial.println("⚠️ Command too long");
+      } else if (console.length > 0) {
+        console.buffer[console.length] = '\0';
+        handleCommand(console.buffer);
+      }
+      console.length = 0;
+      console.overflow = false;
+    } else if (console.length < CONSOLE_BUFFER_SIZE - 1) {
+      console.buffer[console.length++] = c;
+    } else {
+      console.overflow = true; // Drop the rest of the line
+    }
+  }
+  
+  recordConsoleTime(micros() - startTime);
+}
+
+// Splits the line in place on spaces, returns the number of tokens
+int tokenizeCommand(char* line, char* tokens[], int maxTokens) {
+  int count = 0;
+  char* p = line;
+  
+  while (*p != '\0' && count < maxTokens) {
+    while (*p == ' ') p++;
+    if (*p == '\0') break;
+    tokens[count++] = p;
+    while (*p != '\0' && *p != ' ') p++;
+    if (*p == ' ') *p++ = '\0';
+  }
+  return count;
+}
+
+bool parseNumber(const char* text, unsigned long maxValue, unsigned long &value) {
+  if (text == NULL || *text == '\0') return false;
+  
+  unsigned long result = 0;
+  for (const char* p = text; *p != '\0'; p++) {
+    if (*p < '0' || *p > '9') return false;
+    result = result * 10 + (*p - '0');
+    if (result > maxValue) return false;
+  }
+  value = result;
+  return true;
+}
+
+bool setSetting(const char* key, const char* text) {
+  unsigned long value;
+  
+  if (strcmp(key, "points") == 0 && parseNumber(text, 99, value) && value > 0) {
+    settings.pointsToWin = value;
+  } else if (strcmp(key, "threshold") == 0 && parseNumber(text, 255, value) && value > 0) {
+    settings.irBlockedThreshold = value;
+  } else if (strcmp(key, "debounce") == 0 && parseNumber(text, 65535, value)) {
+    settings.irDebounceTime = value;
+  } else if (strcmp(key, "brightness") == 0 && parseNumber(text, 255, value)) {
+    settings.brightness = value;
+    if (!isCelebrationActive()) {
+      setBrightness(settings.brightness);
+    }
+  } else if (strcmp(key, "goalms") == 0 && parseNumber(text, 65535, value)) {
+    settings.goalCelebrationDuration = value;
+  } else if (strcmp(key, "winms") == 0 && parseNumber(text, 65535, value)) {
+    settings.gameWinCelebrationDuration = value;
+  } else if (strcmp(key, "power") == 0 && parseNumber(text, 65535, value)) {
+    settings.powerBudget = value;
+  } else if (strcmp(key, "latency") == 0 && parseNumber(text, 65535, value) && value > 0) {
+    settings.latencyBudget = value;
+  } else if (strcmp(key, "maxblock") == 0 && parseNumber(text, 65535, value)) {
+    settings.goalMaxBlockTime = value;
+  } else if (strcmp(key, "rebreakms") == 0 && parseNumber(text, 65535, value)) {
+    settings.goalRebreakWindow = value;
+  } else if (strcmp(key, "rebreaks") == 0 && parseNumber(text, 255, value) && value > 0) {
+    settings.goalMaxRebreaks = value;
+  } else if (strcmp(key, "dwell") == 0 && parseNumber(text, 255, value)) {
+    settings.goalClearDwell = value;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Settings read directly by the game logic take effect on their own;
+// brightness has to be pushed to the strip
+void applyLoadedSettings() {
+  if (!isCelebrationActive()) {
+    setBrightness(settings.brightness);
+  }
+}
+
+bool selectEffect(const char* name) {
+  if (strcmp(name, "off") == 0) {
+    setLEDEffect(LED_OFF);
+  } else if (strcmp(name, "white") == 0) {
+    setLEDEffect(LED_FULL_WHITE);
+  } else if (strcmp(name, "wave") == 0) {
+    setLEDEffect(LED_COLOR_WAVE);
+  } else if (strcmp(name, "rainbow") == 0) {
+    setLEDEffect(LED_RAINBOW_WAVE);
+  } else if (strcmp(name, "breathing") == 0) {
+    setLEDEffect(LED_BREATHING);
+  } else if (strcmp(name, "vm") == 0) {
+    setLEDEffect(LED_VM_PROGRAM);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool handleVMCommand(const char* action, const char* arg) {
+  unsigned long value;
+  
+  if (strcmp(action, "demo") == 0) {
+    if (!parseNumber(arg, 255, value) || !loadBuiltinVMProgram(value)) return false;
+    setLEDEffect(LED_VM_PROGRAM);
+    resetVM();
+  } else if (strcmp(action, "clear") == 0) {
+    clearLoadedVMProgram();
+  } else if (strcmp(action, "add") == 0) {
+    if (arg == NULL || !appendVMProgram(arg)) return false;
+  } else if (strcmp(action, "run") == 0) {
+    return runLoadedVMProgram();
+  } else if (strcmp(action, "bench") == 0) {
+    benchmarkVM();
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void handleCommand(char* line) {
+  char* tokens[CONSOLE_MAX_TOKENS];
+  int count = tokenizeCommand(line, tokens, CONSOLE_MAX_TOKENS);
+  if (count == 0) return;
+  
+  const char* command = tokens[0];
+  
+  if (strcmp(command, "help") == 0) {
+    printConsoleHelp();
+  } else if (strcmp(command, "get") == 0) {
+    printSettings();
+  } else if (strcmp(command, "set") == 0) {
+    if (count < 3 || !setSetting(tokens[1], tokens[2])) {
+      Serial.println("⚠️ Usage: set <key> <value> - see 'get' for keys");
+    } else {
+      Serial.print(tokens[1]);
+      Serial.print(" = ");
+      Serial.println(tokens[2]);
+    }
+  } else if (strcmp(command, "save") == 0) {
+    saveSettings();
+  } else if (strcmp(command, "load") == 0) {
+    loadSettings();
+    applyLoadedSettings();
+  } else if (strcmp(command, "defaults") == 0) {
+    resetSettings();
+    applyLoadedSettings();
+    Serial.println("Settings reset to defaults (not saved)");
+  } else if (strcmp(command, "effect") == 0) {
+    if (count < 2 || !selectEffect(tokens[1])) {
+      Serial.println("⚠️ Usage: effect <off|white|wave|rainbow|breathing|vm>");
+    }
+  } else if (strcmp(command, "start") == 0) {
+    startNewGame();
+  } else if (strcmp(command, "reset") == 0) {
+    startNewGame(); // Score, match stats and game state stay in step
+  } else if (strcmp(command, "stats") == 0) {
+    printGameStatus();
+    printMatchStats();
+    printSensorStatus();
+    printLoopStats();
+    printFrameStats();
+  } else if (strcmp(command, "vm") == 0) {
+    if (count < 2 || !handleVMCommand(tokens[1], count > 2 ? tokens[2] : NULL)) {
+      Serial.println("⚠️ Usage: vm <demo n|clear|add hex|run|bench>");
+    }
+  } else if (strcmp(command, "golden") == 0) {
+    runGoldenFrames(count > 1 && strcmp(tokens[1], "table") == 0);
+  } else if (strcmp(command, "dump") == 0) {
+    dumpFrame();
+  } else if (strcmp(command, "seed") == 0) {
+    unsigned long value;
+    if (count < 2 || !parseNumber(tokens[1], 999999999, value)) {
+      Serial.println("⚠️ Usage: seed <number>");
+    } else {
+      setEffectRandomSeed(value);
+    }
+  } else if (strcmp(command, "latency") == 0) {
+    printLatencyStats();
+  } else if (strcmp(command, "mem") == 0) {
+    printMemoryReport();
+  } else if (strcmp(command, "bench") == 0) {
+    if (count > 1 && strcmp(tokens[1], "fx") == 0) {
+      benchmarkEffects();
+    } else if (count > 1 && strcmp(tokens[1], "goal") == 0) {
+      benchmarkGoalLatency();
+    } else {
+      resetLoopStats();
+      Serial.println("Loop timing reset - run 'stats' to read it back");
+    }
+  } else {
+    Serial.print("⚠️ Unknown command: ");
+    Serial.println(command);
+  }
+}
+
+void printConsoleHelp() {
+  Serial.println("Commands:");
+  Serial.println("  help                  - this list");
+  Serial.println("  get                   - show settings");
+  Serial.println("  set <key> <value>     - change a setting");
+  Serial.println("  save | load | defaults - NVS persistence");
+  Serial.println("  effect <name>         - off, white, wave, rainbow, breathing, vm");
+  Serial.println("  start                 - start a new game");
+  Serial.println("  reset                 - reset score and match stats");
+  Serial.println("  stats                 - game, match, sensor, loop and frame stats");
+  Serial.println("  vm <demo n|clear|add hex|run|bench> - bytecode animations");
+  Serial.println("  mem                   - RAM, stack and heap usage");
+  Serial.println("  bench [fx|goal]       - restart loop timing, time effects or goal-to-light");
+  Serial.println("  latency               - goal-to-light latency by stage");
+  Serial.println("  golden [table]        - check every effect against its golden frames");
+  Serial.println("  dump                  - current frame as PPM");
+  Serial.println("  seed <n>              - reseed sparkle randomness");
+}
@@ -0,0 +1,101 @@
+#include "settings.h"
+#include "ir-controller.h"
+#include "led-controller.h"
+#include "goal-classifier.h"
+#include "diagnostics.h"
+#include <Preferences.h>
+
+Settings settings;
+
+void resetSettings() {
+  settings.pointsToWin = POINTS_TO_WIN;
+  settings.irBlockedThreshold = IR_BLOCKED_THRESHOLD;
+  settings.irDebounceTime = IR_DEBOUNCE_TIME;
+  settings.brightness = BRIGHTNESS;
+  settings.goalCelebrationDuration = GOAL_CELEBRATION_DURATION;
+  settings.gameWinCelebrationDuration = GAME_WIN_CELEBRATION_DURATION;
+  settings.powerBudget = POWER_BUDGET_MA;
+  settings.latencyBudget = GOAL_LATENCY_BUDGET;
+  settings.goalMaxBlockTime = GOAL_MAX_BLOCK_TIME;
+  settings.goalRebreakWindow = GOAL_REBREAK_WINDOW;
+  settings.goalMaxRebreaks = GOAL_MAX_REBREAKS;
+  settings.goalClearDwell = GOAL_CLEAR_DWELL;
+}
+
+void loadSettings() {
+  resetSettings();
+  
+  Preferences prefs;
+  if (!prefs.begin(SETTINGS_NAMESPACE, true)) {
+    Serial.println("No saved settings - using defaults");
+    return;
+  }
+  
+  settings.pointsToWin = prefs.getUChar("points", settings.pointsToWin);
+  settings.irBlockedThreshold = prefs.getUChar("threshold", settings.irBlockedThreshold);
+  settings.irDebounceTime = prefs.getUShort("debounce", settings.irDebounceTime);
+  settings.brightness = prefs.getUChar("brightness", settings.brightness);
+  settings.goalCelebrationDuration = prefs.getUShort("goalms", settings.goalCelebrationDuration);
+  settings.gameWinCelebrationDuration = prefs.getUShort("winms", settings.gameWinCelebrationDuration);
+  settings.powerBudget = prefs.getUShort("power", settings.powerBudget);
+  settings.latencyBudget = prefs.getUShort("latency", settings.latencyBudget);
+  settings.goalMaxBlockTime = prefs.getUShort("maxblock", settings.goalMaxBlockTime);
+  settings.goalRebreakWindow = prefs.getUShort("rebreakms", settings.goalRebreakWindow);
+  settings.goalMaxRebreaks = prefs.getUChar("rebreaks", settings.goalMaxRebreaks);
+  settings.goalClearDwell = prefs.getUChar("dwell", settings.goalClearDwell);
+  prefs.end();
+  
+  Serial.println("Settings loaded from NVS");
+}
+
+void saveSettings() {
+  Preferences prefs;
+  if (!prefs.begin(SETTINGS_NAMESPACE, false)) {
+    Serial.println("⚠️ Could not open NVS - settings not saved");
+    return;
+  }
+  
+  prefs.putUChar("points", settings.pointsToWin);
+  prefs.putUChar("threshold", settings.irBlockedThreshold);
+  prefs.putUShort("debounce", settings.irDebounceTime);
+  prefs.putUChar("brightness", settings.brightness);
+  prefs.putUShort("goalms", settings.goalCelebrationDuration);
+  prefs.putUShort("winms", settings.gameWinCelebrationDuration);
+  prefs.putUShort("power", settings.powerBudget);
+  prefs.putUShort("latency", settings.latencyBudget);
+  prefs.putUShort("maxblock", settings.goalMaxBlockTime);
+  prefs.putUShort("rebreakms", settings.goalRebreakWindow);
+  prefs.putUChar("rebreaks", settings.goalMaxRebreaks);
+  prefs.putUChar("dwell", settings.goalClearDwell);
+  prefs.end();
+  
+  Serial.println("Settings saved to NVS");
+}
+
+void printSettings() {
+  Serial.println("⚙️ Settings:");
+  Serial.print("points     = ");
+  Serial.println(settings.pointsToWin);
+  Serial.print("threshold  = ");
+  Serial.println(settings.irBlockedThreshold);
+  Serial.print("debounce   = ");
+  Serial.println(settings.irDebounceTime);
+  Serial.print("brightness = ");
+  Serial.println(settings.brightness);
+  Serial.print("goalms     = ");
+  Serial.println(settings.goalCelebrationDuration);
+  Serial.print("winms      = ");
+  Serial.println(settings.gameWinCelebrationDuration);
+  Serial.print("power      = ");
+  Serial.println(settings.powerBudget);
+  Serial.print("latency    = ");
+  Serial.println(settings.latencyBudget);
+  Serial.print("maxblock   = ");
+  Serial.println(settings.goalMaxBlockTime);
+  Serial.print("rebreakms  = ");
+  Serial.println(settings.goalRebreakWindow);
+  Serial.print("rebreaks   = ");
+  Serial.println(settings.goalMaxRebreaks);
+  Serial.print("dwell      = ");
+  Serial.println(settings.goalClearDwell);
+}
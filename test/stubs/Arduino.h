@@ -0,0 +1,77 @@
+#ifndef ARDUINO_STUB_H
+#define ARDUINO_STUB_H
+
+// Host stand-in for the parts of the ESP32 Arduino core the firmware uses,
+// so src/ can be built and tested with [env:native]
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define INPUT_PULLUP 2
+#define HIGH 1
+#define LOW 0
+#define HEX 16
+#define DEC 10
+#define F(x) (x)
+
+using std::min;
+using std::max;
+
+// Virtual clock, tests move it by hand
+extern unsigned long stubMillis;
+inline unsigned long millis() { return stubMillis; }
+inline unsigned long micros() { return stubMillis * 1000; }
+inline void delay(unsigned long ms) { stubMillis += ms; }
+
+// Pins read HIGH (beam clear)
+inline void pinMode(int, int) {}
+inline int digitalRead(int) { return HIGH; }
+
+inline long random(long range) { return rand() % range; }
+inline long random(long low, long high) { return low + rand() % (high - low); }
+inline void randomSeed(unsigned long seed) { srand(seed); }
+inline uint32_t esp_random() { return (uint32_t)rand(); }
+
+// Prints go to stdout
+struct Print {
+  size_t print(const char* text) { return ::printf("%s", text); }
+  size_t print(char c) { return ::printf("%c", c); }
+  size_t print(int value, int base = DEC) { return ::printf(base == HEX ? "%X" : "%d", value); }
+  size_t print(unsigned value, int base = DEC) { return ::printf(base == HEX ? "%X" : "%u", value); }
+  size_t print(long value, int base = DEC) { return ::printf(base == HEX ? "%lX" : "%ld", value); }
+  size_t print(unsigned long value, int base = DEC) { return ::printf(base == HEX ? "%lX" : "%lu", value); }
+  size_t print(double value, int digits = 2) { return ::printf("%.*f", digits, value); }
+  template <class T> size_t println(T value) { return print(value) + println(); }
+  template <class T> size_t println(T value, int format) { return print(value, format) + println(); }
+  size_t println() { return ::printf("\n"); }
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+struct HardwareSerial : Print {
+  void begin(unsigned long) {}
+  size_t setTxBufferSize(size_t size) { return size; }
+  int available() { return 0; }
+  int read() { return -1; }
+  size_t availableForWrite() { return 128; }
+};
+extern HardwareSerial Serial;
+
+struct EspClass {
+  uint32_t getFreeHeap() { return 200000; }
+  uint32_t getMinFreeHeap() { return 190000; }
+  uint32_t getHeapSize() { return 300000; }
+  uint32_t getMaxAllocHeap() { return 100000; }
+};
+extern EspClass ESP;
+
+typedef void* TaskHandle_t;
+inline unsigned uxTaskGetStackHighWaterMark(TaskHandle_t) { return 4096; }
+
+#endif // ARDUINO_STUB_H
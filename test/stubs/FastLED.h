@@ -0,0 +1,126 @@
+#ifndef FASTLED_STUB_H
+#define FASTLED_STUB_H
+
+// Host stand-in for FastLED. The math matches FastLED 3.6 on the ESP32
+// (FASTLED_SCALE8_FIXED, sin8_C) so frames hash the same as on the device.
+
+#include <stdint.h>
+
+inline uint8_t scale8(uint8_t i, uint8_t scale) {
+  return ((uint16_t)i * (1 + scale)) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, uint8_t scale) {
+  return (((int)i * (int)scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t qadd8(uint8_t a, uint8_t b) {
+  int sum = a + b;
+  return (sum > 255) ? 255 : sum;
+}
+
+inline uint8_t sin8(uint8_t theta) {
+  static const uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+  uint8_t offset = theta;
+  if (theta & 0x40) offset = (uint8_t)255 - offset;
+  offset &= 0x3F;
+  
+  uint8_t secoffset = offset & 0x0F;
+  if (theta & 0x40) secoffset++;
+  
+  uint8_t section = offset >> 4;
+  uint8_t s2 = section * 2;
+  uint8_t b = b_m16_interleave[s2];
+  uint8_t m16 = b_m16_interleave[s2 + 1];
+  uint8_t mx = (m16 * secoffset) >> 4;
+  
+  int8_t y = mx + b;
+  if (theta & 0x80) y = -y;
+  y += 128;
+  return y;
+}
+
+struct CHSV {
+  uint8_t h, s, v;
+  CHSV(uint8_t hue, uint8_t saturation, uint8_t value) : h(hue), s(saturation), v(value) {}
+};
+
+struct CRGB {
+  union {
+    struct { uint8_t r, g, b; };
+    uint8_t raw[3];
+  };
+  
+  enum HTMLColorCode {
+    Black = 0x000000, White = 0xFFFFFF, Red = 0xFF0000, Green = 0x008000,
+    Blue = 0x0000FF, Yellow = 0xFFFF00, Orange = 0xFFA500, Purple = 0x800080
+  };
+  
+  CRGB() {}
+  constexpr CRGB(uint8_t red, uint8_t green, uint8_t blue) : r(red), g(green), b(blue) {}
+  CRGB(HTMLColorCode code) : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF) {}
+  CRGB(uint32_t code) : r((code >> 16) & 0xFF), g((code >> 8) & 0xFF), b(code & 0xFF) {}
+  
+  // Plain six-sector conversion, not FastLED's rainbow mapping. Only the
+  // divide + CHSV benchmark baseline uses it, and nothing checks its colors.
+  CRGB(const CHSV& hsv) {
+    uint8_t sector = hsv.h / 43;
+    uint8_t rise = (hsv.h - sector * 43) * 6;
+    uint8_t low = scale8(hsv.v, 255 - hsv.s);
+    uint8_t up = low + scale8(hsv.v - low, rise);
+    uint8_t down = hsv.v - scale8(hsv.v - low, rise);
+    switch (sector) {
+      case 0: r = hsv.v; g = up; b = low; break;
+      case 1: r = down; g = hsv.v; b = low; break;
+      case 2: r = low; g = hsv.v; b = up; break;
+      case 3: r = low; g = down; b = hsv.v; break;
+      case 4: r = up; g = low; b = hsv.v; break;
+      default: r = hsv.v; g = low; b = down; break;
+    }
+  }
+  
+  CRGB& nscale8(uint8_t scale) {
+    r = scale8(r, scale);
+    g = scale8(g, scale);
+    b = scale8(b, scale);
+    return *this;
+  }
+  CRGB& nscale8_video(uint8_t scale) {
+    r = scale8_video(r, scale);
+    g = scale8_video(g, scale);
+    b = scale8_video(b, scale);
+    return *this;
+  }
+  CRGB& fadeToBlackBy(uint8_t fadeFactor) { return nscale8(255 - fadeFactor); }
+  
+  uint8_t& operator[](int index) { return raw[index]; }
+  explicit operator bool() const { return r || g || b; }
+};
+
+inline bool operator==(const CRGB& a, const CRGB& b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+inline bool operator!=(const CRGB& a, const CRGB& b) { return !(a == b); }
+
+enum { WS2812B };
+enum { GRB };
+
+// Keeps the brightness and counts shows, nothing is sent anywhere
+struct CFastLED {
+  uint8_t brightness = 255;
+  unsigned showCount = 0;
+  CRGB* leds = nullptr;
+  int ledCount = 0;
+  
+  template <int CHIPSET, int DATA_PIN, int ORDER> void addLeds(CRGB* data, int count) {
+    leds = data;
+    ledCount = count;
+  }
+  void setBrightness(uint8_t value) { brightness = value; }
+  uint8_t getBrightness() { return brightness; }
+  void clear() {
+    for (int i = 0; i < ledCount; i++) leds[i] = CRGB(0, 0, 0);
+  }
+  void show() { showCount++; }
+};
+extern CFastLED FastLED;
+
+#endif // FASTLED_STUB_H
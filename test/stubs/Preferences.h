@@ -0,0 +1,27 @@
+#ifndef PREFERENCES_STUB_H
+#define PREFERENCES_STUB_H
+
+// Host stand-in for ESP32 NVS preferences: nothing is stored, every read
+// returns its default
+
+#include <stdint.h>
+#include <stddef.h>
+
+struct Preferences {
+  bool begin(const char*, bool = false) { return true; }
+  void end() {}
+  bool clear() { return true; }
+  bool isKey(const char*) { return false; }
+  
+  uint8_t getUChar(const char*, uint8_t defaultValue = 0) { return defaultValue; }
+  size_t putUChar(const char*, uint8_t) { return 1; }
+  uint16_t getUShort(const char*, uint16_t defaultValue = 0) { return defaultValue; }
+  size_t putUShort(const char*, uint16_t) { return 2; }
+  uint32_t getUInt(const char*, uint32_t defaultValue = 0) { return defaultValue; }
+  size_t putUInt(const char*, uint32_t) { return 4; }
+  size_t getBytes(const char*, void*, size_t) { return 0; }
+  size_t putBytes(const char*, const void*, size_t length) { return length; }
+  size_t getBytesLength(const char*) { return 0; }
+};
+
+#endif // PREFERENCES_STUB_H
@@ -0,0 +1,23 @@
+// Globals behind the host stubs, built into src/ for [env:native] only
+
+#include <Arduino.h>
+#include <FastLED.h>
+#include <stdarg.h>
+
+unsigned long stubMillis = 0;
+HardwareSerial Serial;
+EspClass ESP;
+CFastLED FastLED;
+
+size_t Print::printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int written = vprintf(format, args);
+  va_end(args);
+  return (written > 0) ? written : 0;
+}
+
+// Section bounds the memory report reads from the ESP32 linker script
+extern "C" {
+  unsigned char _data_start, _data_end, _bss_start, _bss_end;
+}
@@ -0,0 +1,82 @@
+// Renders every effect on the host and checks each frame against the golden
+// CRCs. Run with: pio test -e native
+// A mismatching frame is written as golden-<effect>-<frame>.ppm (one-row P3
+// image of the used sections) next to where the test runs.
+
+#include <unity.h>
+#include <stdio.h>
+#include "golden-frames.h"
+#include "settings.h"
+
+void setUp() {}
+void tearDown() {}
+
+void writeFramePPM(int effect, int frameIndex) {
+  char path[64];
+  snprintf(path, sizeof(path), "golden-%s-%02d.ppm", getGoldenEffectName(effect), frameIndex);
+  for (char* c = path; *c; c++) {
+    if (*c == ' ') *c = '_';
+  }
+
+  FILE* file = fopen(path, "w");
+  if (!file) return;
+  fprintf(file, "P3\n%d 1\n255\n", SECTION_4_END + 1);
+  for (int i = 0; i <= SECTION_4_END; i++) {
+    fprintf(file, "%d %d %d\n", leds[i].r, leds[i].g, leds[i].b);
+  }
+  fclose(file);
+}
+
+void checkEffect(LEDEffect effect) {
+  beginGoldenEffect(effect);
+
+  int mismatches = 0;
+  int firstMismatch = -1;
+  for (int i = 0; i < GOLDEN_FRAMES; i++) {
+    uint32_t crc = renderGoldenFrame(effect, i);
+    if (crc == goldenFrameCRCs[effect][i]) continue;
+    writeFramePPM(effect, i);
+    if (mismatches == 0) firstMismatch = i;
+    mismatches++;
+  }
+
+  char message[96];
+  snprintf(message, sizeof(message), "%s: %d/%d frames differ, first is frame %d (see golden-*.ppm)",
+           getGoldenEffectName(effect), mismatches, GOLDEN_FRAMES, firstMismatch);
+  TEST_ASSERT_EQUAL_INT_MESSAGE(0, mismatches, message);
+}
+
+void test_golden_off() { checkEffect(LED_OFF); }
+void test_golden_white() { checkEffect(LED_FULL_WHITE); }
+void test_golden_wave() { checkEffect(LED_COLOR_WAVE); }
+void test_golden_rainbow() { checkEffect(LED_RAINBOW_WAVE); }
+void test_golden_breathing() { checkEffect(LED_BREATHING); }
+void test_golden_vm() { checkEffect(LED_VM_PROGRAM); }
+void test_golden_goal_a() { checkEffect(LED_GOAL_CELEBRATION_A); }
+void test_golden_goal_b() { checkEffect(LED_GOAL_CELEBRATION_B); }
+void test_golden_win_a() { checkEffect(LED_GAME_WIN_CELEBRATION_A); }
+void test_golden_win_b() { checkEffect(LED_GAME_WIN_CELEBRATION_B); }
+
+// Every effect must have a test above
+void test_golden_covers_every_effect() {
+  TEST_ASSERT_EQUAL_INT(GOLDEN_EFFECT_COUNT, LED_GAME_WIN_CELEBRATION_B + 1);
+}
+
+int main() {
+  resetSettings();
+  initLEDs();
+
+  UNITY_BEGIN();
+  RUN_TEST(test_golden_covers_every_effect);
+  RUN_TEST(test_golden_off);
+  RUN_TEST(test_golden_white);
+  RUN_TEST(test_golden_wave);
+  RUN_TEST(test_golden_rainbow);
+  RUN_TEST(test_golden_breathing);
+  RUN_TEST(test_golden_vm);
+  RUN_TEST(test_golden_goal_a);
+  RUN_TEST(test_golden_goal_b);
+  RUN_TEST(test_golden_win_a);
+  RUN_TEST(test_golden_win_b);
+  return UNITY_END();
+}